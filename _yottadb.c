@@ -2,7 +2,7 @@
  *                                                              *
  * Copyright (c) 2019-2021 Peter Goss All rights reserved.      *
  *                                                              *
- * Copyright (c) 2019-2025 YottaDB LLC and/or its subsidiaries. *
+ * Copyright (c) 2019-2026 YottaDB LLC and/or its subsidiaries. *
  * All rights reserved.                                         *
  *                                                              *
  *  This source code contains the intellectual property         *
@@ -32,24 +32,40 @@
 		return RET;                   \
 	}
 
-/* Utility structure for maintaining call-in information
- * used in ydb_cip calls.
- *
- * This struct serves as an anchor point for the C call-in routine descriptor
- * used by cip() that provides for less call-in overhead than ci() as the descriptor
- * contains fastpath information filled in by YottaDB after the first call. This allows
- * subsequent calls to have minimal overhead. Because this structure's contents contain
- * pointers to C allocated storage, it is not exposed to Python-level users.
- */
-typedef struct {
-	char *		   routine_name;
-	bool		   has_parm_types;
-	ci_name_descriptor ci_info;
-	ci_parm_type	   parm_types;
-} py_ci_name_descriptor;
-
-// Initialize a global struct to store call-in information
-py_ci_name_descriptor ci_info = {.routine_name = NULL, .has_parm_types = FALSE, .ci_info = {.handle = NULL}};
+/* The state of the module in the calling interpreter, i.e. the state of the module passed to the function being run by
+ * the wrapper defined by DEFINE_SERIALIZED. It is set while api_lock is held, so it is only accessed by one thread at a time.
+ */
+static YDBPyModuleState *module_state;
+
+/* Serializes the module functions of all interpreters, including their access to module_state. The lock is recursive,
+ * since the callback of tp() may call module functions on the same thread.
+ */
+static pthread_mutex_t api_lock;
+static pthread_once_t  api_lock_once = PTHREAD_ONCE_INIT;
+
+/* Initialize api_lock, when the module is initialized and again in a child process after fork(), where it may have been
+ * copied while held by another thread of the parent process.
+ */
+static void init_api_lock(void) {
+	pthread_mutexattr_t attr;
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&api_lock, &attr);
+	pthread_mutexattr_destroy(&attr);
+}
+
+/* Acquire api_lock, detaching the calling thread from the interpreter while it waits, so that the thread holding the lock
+ * can run Python code, e.g. in a tp() callback. Otherwise, the holder would wait forever for the GIL, or in free-threaded
+ * builds of CPython, for the waiting thread to pause, as it does for garbage collection.
+ */
+static void acquire_api_lock(void) {
+	if (0 != pthread_mutex_trylock(&api_lock)) {
+		Py_BEGIN_ALLOW_THREADS;
+		pthread_mutex_lock(&api_lock);
+		Py_END_ALLOW_THREADS;
+	}
+}
 
 /* Counts the total number of arguments between two integer bitmaps,
  * one representing input arguments and another representing output
@@ -121,29 +137,43 @@ static void raise_ValidationError(YDBPythonErrorType err_type, char *format_pref
 	}
 }
 
+/* Get the UTF-8 encoding of a Python `str` object. CPython caches the encoding in the object, so recurring `str` objects,
+ * e.g. interned subscripts such as literals, are only encoded once, and ASCII strings, which are their own encoding, are
+ * never encoded. Whether the encoding of a non-ASCII string is already cached is not exposed by the public API, so ASCII
+ * strings are counted as hits and all other strings as potential misses, in the module state. The counts are reported
+ * by utf8_cache_stats().
+ */
+static const char *str_to_utf8(PyObject *object, Py_ssize_t *len) {
+	if (PyUnicode_IS_ASCII(object)) {
+		module_state->utf8_cache_hits++;
+	} else {
+		module_state->utf8_cache_misses++;
+	}
+	return PyUnicode_AsUTF8AndSize(object, len);
+}
+
 /* Convert a PyObject referencing a Python `bytes` or `str` object to a ydb_buffer_t struct
  * and validate the size of resulting buffer to enforce YottaDB variable name and value limits.
  * If set, the `is_varname` flag signals that the object should be validated as a variable,
  * otherwise the object will be validated as a value.
  */
 static int anystr_to_buffer(PyObject *object, ydb_buffer_t *buffer, bool is_varname) {
-	char *	     bytes;
-	bool	     decref_object;
+	const char * bytes;
 	Py_ssize_t   bytes_ssize;
 	unsigned int bytes_len;
 	int	     done;
 
 	if (PyUnicode_Check(object)) {
-		// Convert Unicode object into Python bytes object
-		object = PyUnicode_AsEncodedString(object, "utf-8", "strict"); // New reference
-		if (NULL == object) {
-			PyErr_SetString(YDBPythonError, "failed to encode Unicode string to bytes object");
+		// Use the UTF-8 encoding of the Unicode object instead of encoding it into a new Python bytes object
+		bytes = str_to_utf8(object, &bytes_ssize);
+		if (NULL == bytes) {
+			PyErr_SetString(module_state->YDBPythonError, "failed to encode Unicode string to bytes object");
 			return !YDB_OK;
 		}
-		decref_object = TRUE;
 	} else if (PyBytes_Check(object)) {
 		// Object is a bytes object, no Unicode encoding needed
-		decref_object = FALSE;
+		bytes = PyBytes_AS_STRING(object);
+		bytes_ssize = PyBytes_GET_SIZE(object);
 	} else {
 		/* Object is not bytes or str (Unicode), but one of these types was expected.
 		 * So, raise an exception.
@@ -152,41 +182,27 @@ static int anystr_to_buffer(PyObject *object, ydb_buffer_t *buffer, bool is_varn
 		return !YDB_OK;
 	}
 
-	// Convert Python bytes object to C character string (char *)
-	bytes_ssize = PyBytes_Size(object);
 	if (INT32_MAX < bytes_ssize) {
 		/* Python bytes objects may have more bytes than can be represented by a 32-bit unsigned integer.
 		 * If `object` is 1 more than INT32_MAX, `bytes_len` below would be set to 0, falsely indicating a
 		 * 0-byte long bytes object. So, we need to detect this integer overflow before calling Py_SAFE_DOWNCAST,
-		 * in which case we raise an exception, cleanup, and return the failure to the caller.
+		 * in which case we raise an exception and return the failure to the caller.
 		 */
 		if (is_varname) {
 			raise_ValidationError(YDBPython_ValueError, NULL, YDBPY_ERR_VARNAME_TOO_LONG, bytes_ssize, YDB_MAX_IDENT);
 		} else {
 			raise_ValidationError(YDBPython_ValueError, NULL, YDBPY_ERR_BYTES_TOO_LONG, bytes_ssize, YDB_MAX_STR);
 		}
-		if (decref_object) {
-			// Optionally cleanup new reference
-			Py_DECREF(object);
-		}
 		return !YDB_OK;
 	}
 	bytes_len = Py_SAFE_DOWNCAST(bytes_ssize, Py_ssize_t, unsigned int);
-	bytes = PyBytes_AsString(object);
 
 	// Allocate and populate YDB buffer
 	YDB_MALLOC_BUFFER(buffer, bytes_len + 1); // Null terminator used in some scenarios
 	YDB_COPY_BYTES_TO_BUFFER(bytes, bytes_len, buffer, done);
 	buffer->buf_addr[buffer->len_used] = '\0';
-
-	// Optionally cleanup new reference
-	if (decref_object) {
-		Py_DECREF(object);
-	}
-
-	// Defer error emission until after optional cleanup to reduce duplication
 	if (!done) {
-		PyErr_SetString(YDBPythonError, "failed to copy bytes object to buffer array");
+		PyErr_SetString(module_state->YDBPythonError, "failed to copy bytes object to buffer array");
 		YDB_FREE_BUFFER(buffer);
 		return !YDB_OK;
 	}
@@ -213,22 +229,21 @@ static int anystr_to_buffer(PyObject *object, ydb_buffer_t *buffer, bool is_varn
 }
 
 static int anystr_to_ydb_string_t(PyObject *object, ydb_string_t *buffer) {
-	char *	     bytes;
-	bool	     decref_object;
+	const char * bytes;
 	Py_ssize_t   bytes_ssize;
 	unsigned int bytes_len;
 
 	if (PyUnicode_Check(object)) {
-		// Convert Unicode object into Python bytes object
-		object = PyUnicode_AsEncodedString(object, "utf-8", "strict"); // New reference
-		if (NULL == object) {
-			PyErr_SetString(YDBPythonError, "failed to encode Unicode string to bytes object");
+		// Use the UTF-8 encoding of the Unicode object instead of encoding it into a new Python bytes object
+		bytes = str_to_utf8(object, &bytes_ssize);
+		if (NULL == bytes) {
+			PyErr_SetString(module_state->YDBPythonError, "failed to encode Unicode string to bytes object");
 			return !YDB_OK;
 		}
-		decref_object = TRUE;
 	} else if (PyBytes_Check(object)) {
 		// Object is a bytes object, no Unicode encoding needed
-		decref_object = FALSE;
+		bytes = PyBytes_AS_STRING(object);
+		bytes_ssize = PyBytes_GET_SIZE(object);
 	} else {
 		/* Object is not bytes or str (Unicode). Signal this to
 		 * the caller and let it decide whether to issue an error
@@ -236,22 +251,13 @@ static int anystr_to_ydb_string_t(PyObject *object, ydb_string_t *buffer) {
 		 */
 		return YDBPY_CHECK_TYPE;
 	}
-
-	// Convert Python bytes object to C character string (char *)
-	bytes_ssize = PyBytes_Size(object);
 	bytes_len = Py_SAFE_DOWNCAST(bytes_ssize, Py_ssize_t, unsigned int);
-	bytes = PyBytes_AsString(object);
 
 	// Allocate and populate YDB buffer
 	buffer->address = malloc((bytes_len + 1) * sizeof(char)); // Null terminator used in some scenarios
 	memcpy(buffer->address, bytes, bytes_len);
 	buffer->address[bytes_len] = '\0';
 	buffer->length = bytes_len;
-
-	// Optionally cleanup new reference
-	if (decref_object) {
-		Py_DECREF(object);
-	}
 	return YDB_OK;
 }
 
@@ -405,6 +411,70 @@ static PyObject *new_object_from_object_and_string(PyObject *object, ydb_string_
 	return ret;
 }
 
+/* Returns a new Python `int` or `float` object from the number stored in a YDB buffer.
+ *
+ * YottaDB stores numeric values as strings in canonical form, e.g. "-12", ".5", or "1000000".
+ * So, the buffer is parsed directly into a Python number, avoiding the intermediate Python `bytes`
+ * object and the `int(value.decode())` round trip otherwise needed at the Python level.
+ *
+ * Values representing integers are converted to a C `long long` when they have few enough digits
+ * to fit, or else by Python itself to preserve precision for large canonical numbers, e.g. "1E46".
+ *
+ * Parameters:
+ *   buffer      - the YDB buffer containing the value to convert
+ *   number_type - the Python type to convert the value to. YDBPython_IntegerOrFloat converts the
+ *                 value to an `int` if it is an integer and to a `float` otherwise.
+ *
+ * Returns:
+ *   ret	- a new PyObject, or NULL in case of error, in which case a ValueError will have been raised
+ */
+static PyObject *new_number_from_buffer(ydb_buffer_t *buffer, YDBPythonNumberType number_type) {
+	char	     number[CANONICAL_NUMBER_TO_STRING_MAX + 1];
+	char *	     end, *type_name;
+	bool	     is_integer;
+	unsigned int i, digits;
+
+	type_name = (YDBPython_Integer == number_type) ? "integer" : "number";
+	if (CANONICAL_NUMBER_TO_STRING_MAX < buffer->len_used) {
+		raise_ValidationError(YDBPython_ValueError, NULL, YDBPY_ERR_VALUE_TOO_LONG_FOR_NUMBER, type_name, buffer->len_used,
+				      CANONICAL_NUMBER_TO_STRING_MAX);
+		return NULL;
+	}
+	memcpy(number, buffer->buf_addr, buffer->len_used);
+	number[buffer->len_used] = '\0';
+
+	// Check for an optionally signed series of digits, i.e. an integer
+	i = ('-' == number[0]) ? 1 : 0;
+	for (digits = 0; ('0' <= number[i]) && ('9' >= number[i]); i++, digits++)
+		;
+	is_integer = (0 < digits) && (buffer->len_used == i);
+	if (is_integer && (YDBPython_Float != number_type)) {
+		/* Canonical numbers have at most 18 significant digits, so any number with 18 or fewer digits
+		 * fits in a long long. Longer values may still be canonical, e.g. "1" followed by 46 zeros.
+		 */
+		if (18 >= digits) {
+			return PyLong_FromLongLong(strtoll(number, NULL, 10));
+		} else {
+			return PyLong_FromString(number, NULL, 10);
+		}
+	}
+	if (YDBPython_Integer != number_type) {
+		double val;
+
+		/* Only accept digits, sign, decimal point, and exponent characters to prevent strtod()
+		 * from accepting values such as " 1", "inf", "nan", or "0x10" that M would not treat as numbers.
+		 */
+		if ((0 < buffer->len_used) && (buffer->len_used == strspn(number, "0123456789.-+Ee"))) {
+			val = strtod(number, &end);
+			if (('\0' == *end) && (HUGE_VAL != val) && (-HUGE_VAL != val)) {
+				return PyFloat_FromDouble(val);
+			}
+		}
+	}
+	raise_ValidationError(YDBPython_ValueError, NULL, YDBPY_ERR_VALUE_NOT_NUMERIC, type_name, (int)buffer->len_used, number);
+	return NULL;
+}
+
 /* Confirm that the passed PyObject is a valid Python Sequence,
  * i.e. a Sequence of Python `str` (i.e. Unicode) objects.
  *
@@ -524,7 +594,7 @@ int convert_py_sequence_to_ydb_buffer_array(PyObject *sequence, int sequence_len
 
 	seq = PySequence_Fast(sequence, "argument must be iterable"); // New Reference
 	if (!seq) {
-		PyErr_SetString(YDBPythonError, "Can't convert none sequence to buffer array.");
+		PyErr_SetString(module_state->YDBPythonError, "Can't convert none sequence to buffer array.");
 		FREE_BUFFER_ARRAY(buffer_array, 0);
 		return !YDB_OK;
 	}
@@ -563,6 +633,44 @@ int populate_subs_used_and_subsarray(PyObject *pysubs, int *ret_subs_used, ydb_b
 	return status;
 }
 
+/* Create a Python object from a buffer filled by YottaDB: a bytes object, or if `encoding` is not NULL, a str object
+ * decoded with `encoding` and the error handler `errors` directly from the buffer, without an intermediate bytes object.
+ */
+static PyObject *new_object_from_buffer(ydb_buffer_t *buffer, const char *encoding, const char *errors) {
+	if (NULL == encoding) {
+		return PyBytes_FromStringAndSize(buffer->buf_addr, (Py_ssize_t)buffer->len_used);
+	}
+	return PyUnicode_Decode(buffer->buf_addr, (Py_ssize_t)buffer->len_used, encoding, errors);
+}
+
+/* Converts an array of ydb_buffer_ts into a Tuple of Python objects created by new_object_from_buffer().
+ * Returns NULL if any buffer cannot be decoded.
+ *
+ * Parameters:
+ *    buffer_array       - a C array of ydb_buffer_ts
+ *    len                - the length of the above array
+ *    encoding           - the encoding to decode the buffers with, or NULL for bytes objects
+ *    errors             - the error handler used for decoding, e.g. "strict" or "replace"
+ */
+static PyObject *decode_ydb_buffer_array_to_py_tuple(ydb_buffer_t *buffer_array, int len, const char *encoding,
+						     const char *errors) {
+	int	  i;
+	PyObject *return_tuple, *item;
+
+	return_tuple = PyTuple_New(len); // New Reference
+	if (NULL == return_tuple)
+		return NULL;
+	for (i = 0; i < len; i++) {
+		item = new_object_from_buffer(&buffer_array[i], encoding, errors); // New Reference
+		if (NULL == item) {
+			Py_DECREF(return_tuple);
+			return NULL;
+		}
+		PyTuple_SET_ITEM(return_tuple, i, item); // Steals the reference to item
+	}
+	return return_tuple;
+}
+
 /* converts an array of ydb_buffer_ts into a sequence (Tuple) of Python strings.
  *
  * Parameters:
@@ -571,11 +679,19 @@ int populate_subs_used_and_subsarray(PyObject *pysubs, int *ret_subs_used, ydb_b
  */
 PyObject *convert_ydb_buffer_array_to_py_tuple(ydb_buffer_t *buffer_array, int len) {
 	int	  i;
-	PyObject *return_tuple;
+	PyObject *return_tuple, *item;
 
 	return_tuple = PyTuple_New(len); // New Reference
-	for (i = 0; i < len; i++)
-		PyTuple_SetItem(return_tuple, i, Py_BuildValue("y#", buffer_array[i].buf_addr, buffer_array[i].len_used));
+	if (NULL == return_tuple)
+		return NULL;
+	for (i = 0; i < len; i++) {
+		item = Py_BuildValue("y#", buffer_array[i].buf_addr, buffer_array[i].len_used); // New Reference
+		if (NULL == item) {
+			Py_DECREF(return_tuple);
+			return NULL;
+		}
+		PyTuple_SET_ITEM(return_tuple, i, item); // Steals the reference to item
+	}
 	return return_tuple;
 }
 
@@ -595,18 +711,21 @@ static bool load_YDBNode(YDBNode *dest, PyObject *varname, PyObject *subsarray)
 	Py_ssize_t    len_ssize, sequence_len_ssize;
 	unsigned int  len;
 	int	      status;
-	char *	      bytes_c;
+	const char *  bytes_c;
 	ydb_buffer_t *varname_y, *subsarray_y;
 
-	if (!PyBytes_Check(varname)) {
-		// Convert Unicode object to bytes object
-		varname = PyUnicode_AsEncodedString(varname, "utf-8", "strict"); // New reference
-		assert(PyBytes_Check(varname));
+	if (PyBytes_Check(varname)) {
+		bytes_c = PyBytes_AS_STRING(varname);
+		len_ssize = PyBytes_GET_SIZE(varname);
+	} else {
+		// Use the UTF-8 encoding of the Unicode object instead of encoding it into a new Python bytes object
+		bytes_c = str_to_utf8(varname, &len_ssize);
+		if (NULL == bytes_c) {
+			PyErr_SetString(module_state->YDBPythonError, "failed to encode Unicode string to bytes object");
+			return false;
+		}
 	}
-
-	len_ssize = PyBytes_Size(varname);
 	len = Py_SAFE_DOWNCAST(len_ssize, Py_ssize_t, unsigned int);
-	bytes_c = PyBytes_AsString(varname);
 
 	varname_y = malloc(1 * sizeof(ydb_buffer_t));
 	YDB_MALLOC_BUFFER(varname_y, len);
@@ -614,7 +733,7 @@ static bool load_YDBNode(YDBNode *dest, PyObject *varname, PyObject *subsarray)
 	if (!done) {
 		YDB_FREE_BUFFER(varname_y);
 		free(varname_y);
-		PyErr_SetString(YDBPythonError, "failed to copy bytes object to buffer");
+		PyErr_SetString(module_state->YDBPythonError, "failed to copy bytes object to buffer");
 		return false;
 	}
 
@@ -630,7 +749,7 @@ static bool load_YDBNode(YDBNode *dest, PyObject *varname, PyObject *subsarray)
 			YDB_FREE_BUFFER(varname_y);
 			free(varname_y);
 			FREE_BUFFER_ARRAY(subsarray_y, dest->subs_used);
-			PyErr_SetString(YDBPythonError, "failed to covert sequence to buffer array");
+			PyErr_SetString(module_state->YDBPythonError, "failed to covert sequence to buffer array");
 			return false;
 		}
 	} else {
@@ -826,91 +945,375 @@ static void free_YDBNode_array(YDBNode *nodesarray, int len) {
 	}
 }
 
+/* Collation utilities
+ *
+ * The below routines compare subscripts using the M standard collation order used by YottaDB by default,
+ * i.e. the empty string, followed by canonical numbers in numeric order, followed by all other strings in
+ * byte order. They are used by subscript_scan() and node_scan() to evaluate scan boundaries without
+ * returning to Python for each subscript. Alternative collation sequences are not supported.
+ */
+
+/* Returns TRUE if the given string is a canonical number, i.e. a number in the form in which YottaDB
+ * stores numeric subscripts: an optional '-' followed by digits with an optional decimal point, with no
+ * leading zeros in the integer part, no trailing zeros in the fractional part, no trailing decimal point
+ * and at most CANONICAL_NUMBER_MAX_DIGITS significant digits. "-0" is not canonical, but "0" is.
+ */
+static bool is_canonical_number(char *str, unsigned int len) {
+	unsigned int i, first_digit, last_digit, point, digits;
+
+	i = ((0 < len) && ('-' == str[0])) ? 1 : 0;
+	if (i == len)
+		return FALSE;
+	if ('0' == str[i])
+		return (1 == len);
+	point = len;
+	for (first_digit = len, last_digit = 0; i < len; i++) {
+		if ('.' == str[i]) {
+			if (len != point)
+				return FALSE;
+			point = i;
+		} else if (('0' <= str[i]) && ('9' >= str[i])) {
+			if ('0' != str[i]) {
+				if (len == first_digit)
+					first_digit = i;
+				last_digit = i;
+			}
+		} else {
+			return FALSE;
+		}
+	}
+	if ((len != point) && (('0' == str[len - 1]) || ('.' == str[len - 1])))
+		return FALSE;
+	if (len == first_digit)
+		return FALSE; /* No non-zero digits, e.g. "." or "-." */
+	/* Numbers outside of the range of YottaDB numbers are stored as strings */
+	if ((point > first_digit) && (CANONICAL_NUMBER_MAX_INTEGER_DIGITS < point - first_digit))
+		return FALSE;
+	if ((point < first_digit) && (CANONICAL_NUMBER_MAX_FRACTION_ZEROS < first_digit - point - 1))
+		return FALSE;
+	/* Count significant digits, i.e. the digits between the first and last non-zero digits */
+	for (digits = 0, i = first_digit; i <= last_digit; i++) {
+		if ('.' != str[i])
+			digits++;
+	}
+	return (CANONICAL_NUMBER_MAX_DIGITS >= digits);
+}
+
+/* Compare the absolute values of two canonical numbers without a sign. Returns a negative value,
+ * zero or a positive value if `a` is less than, equal to or greater than `b`, respectively.
+ */
+static int compare_canonical_magnitudes(char *a, unsigned int a_len, char *b, unsigned int b_len) {
+	unsigned int a_int_len, b_int_len, a_frac_len, b_frac_len;
+	int	     result;
+	char *	     point;
+
+	point = memchr(a, '.', a_len);
+	a_int_len = (NULL == point) ? a_len : (unsigned int)(point - a);
+	point = memchr(b, '.', b_len);
+	b_int_len = (NULL == point) ? b_len : (unsigned int)(point - b);
+	/* The integer part of a canonical number has no leading zeros, except for "0" itself */
+	if ((1 == a_int_len) && ('0' == a[0]))
+		a_int_len = 0;
+	if ((1 == b_int_len) && ('0' == b[0]))
+		b_int_len = 0;
+	if (a_int_len != b_int_len)
+		return (a_int_len < b_int_len) ? -1 : 1;
+	result = memcmp(a, b, a_int_len);
+	if (0 != result)
+		return result;
+	/* The fractional part of a canonical number has no trailing zeros, so if the common digits
+	 * are equal, the number with more fractional digits is the larger one.
+	 */
+	a_frac_len = (a_int_len < a_len) ? a_len - a_int_len - 1 : 0;
+	b_frac_len = (b_int_len < b_len) ? b_len - b_int_len - 1 : 0;
+	result = memcmp(a + a_len - a_frac_len, b + b_len - b_frac_len, (a_frac_len < b_frac_len) ? a_frac_len : b_frac_len);
+	if (0 != result)
+		return result;
+	return (a_frac_len == b_frac_len) ? 0 : ((a_frac_len < b_frac_len) ? -1 : 1);
+}
+
+/* Compare two byte strings in byte order */
+static int compare_bytes(char *a, unsigned int a_len, char *b, unsigned int b_len) {
+	int result;
+
+	result = memcmp(a, b, (a_len < b_len) ? a_len : b_len);
+	if (0 != result)
+		return result;
+	return (a_len == b_len) ? 0 : ((a_len < b_len) ? -1 : 1);
+}
+
+/* Compare two subscripts in M standard collation order. Returns a negative value, zero or a positive
+ * value if `a` collates before, equal to or after `b`, respectively.
+ */
+static int collate_subscripts(ydb_buffer_t *a, ydb_buffer_t *b) {
+	bool a_is_number, b_is_number, a_is_negative, b_is_negative;
+	int  result;
+
+	if ((0 == a->len_used) || (0 == b->len_used))
+		return (a->len_used == b->len_used) ? 0 : ((0 == a->len_used) ? -1 : 1);
+	a_is_number = is_canonical_number(a->buf_addr, a->len_used);
+	b_is_number = is_canonical_number(b->buf_addr, b->len_used);
+	if (a_is_number && b_is_number) {
+		a_is_negative = ('-' == a->buf_addr[0]);
+		b_is_negative = ('-' == b->buf_addr[0]);
+		if (a_is_negative != b_is_negative)
+			return a_is_negative ? -1 : 1;
+		result = compare_canonical_magnitudes(a->buf_addr + a_is_negative, a->len_used - a_is_negative,
+						      b->buf_addr + b_is_negative, b->len_used - b_is_negative);
+		return a_is_negative ? -result : result;
+	} else if (a_is_number != b_is_number) {
+		return a_is_number ? -1 : 1;
+	}
+	return compare_bytes(a->buf_addr, a->len_used, b->buf_addr, b->len_used);
+}
+
+/* Compare two subscript arrays in M standard collation order, i.e. the order in which ydb_node_next_s()
+ * traverses nodes: subscript by subscript, with a node collating before all of its descendants.
+ */
+static int collate_subsarrays(ydb_buffer_t *a, int a_used, ydb_buffer_t *b, int b_used) {
+	int i, result;
+
+	for (i = 0; (i < a_used) && (i < b_used); i++) {
+		result = collate_subscripts(&a[i], &b[i]);
+		if (0 != result)
+			return result;
+	}
+	return (a_used == b_used) ? 0 : ((a_used < b_used) ? -1 : 1);
+}
+
+/* Copy the contents of one buffer to another, reallocating the destination buffer if it is too small */
+static void copy_buffer(ydb_buffer_t *dest, ydb_buffer_t *src) {
+	if (dest->len_alloc < src->len_used) {
+		YDB_FREE_BUFFER(dest);
+		YDB_MALLOC_BUFFER(dest, src->len_used);
+	}
+	memcpy(dest->buf_addr, src->buf_addr, src->len_used);
+	dest->len_used = src->len_used;
+}
+
+/* Check a subscript returned during a subscript_scan() against the scan boundaries. Since the subscripts are
+ * returned in collation order, the scan can end as soon as a subscript passes `stop` or `start` (in reverse),
+ * or leaves the range of strings beginning with `prefix`. Canonical numbers beginning with `prefix` do not
+ * collate contiguously, so they are skipped rather than ending the scan if `prefix` may begin a number.
+ */
+static YDBPythonScanResult check_subscript_bounds(ydb_buffer_t *subscript, YDBSubscriptBounds *bounds, bool reverse) {
+	int result;
+
+	if ((NULL != bounds->start.buf_addr) && (0 > collate_subscripts(subscript, &bounds->start)))
+		return reverse ? YDBPython_ScanEnd : YDBPython_ScanSkip;
+	if ((NULL != bounds->stop.buf_addr) && (0 <= collate_subscripts(subscript, &bounds->stop)))
+		return reverse ? YDBPython_ScanSkip : YDBPython_ScanEnd;
+	if (NULL != bounds->prefix.buf_addr) {
+		if ((bounds->prefix.len_used <= subscript->len_used)
+		    && (0 == memcmp(subscript->buf_addr, bounds->prefix.buf_addr, bounds->prefix.len_used)))
+			return YDBPython_ScanMatch;
+		if (is_canonical_number(subscript->buf_addr, subscript->len_used)) {
+			/* All numbers collate before all strings */
+			return (reverse && !bounds->prefix_may_be_number) ? YDBPython_ScanEnd : YDBPython_ScanSkip;
+		}
+		result = compare_bytes(subscript->buf_addr, subscript->len_used, bounds->prefix.buf_addr, bounds->prefix.len_used);
+		/* In reverse, numbers that may begin with `prefix` still follow the strings that precede it */
+		if (reverse)
+			return ((0 > result) && !bounds->prefix_may_be_number) ? YDBPython_ScanEnd : YDBPython_ScanSkip;
+		return (0 < result) ? YDBPython_ScanEnd : YDBPython_ScanSkip;
+	}
+	return YDBPython_ScanMatch;
+}
+
+/* Check a node returned during a node_scan() against the scan boundaries. Nodes are returned in depth-first
+ * collation order and the nodes of a subtree are contiguous, so the scan can end as soon as a node passes
+ * `stop` or `start` (in reverse), or leaves the subtree under `prefix`.
+ */
+static YDBPythonScanResult check_node_bounds(ydb_buffer_t *subsarray, int subs_used, YDBNodeBounds *bounds, bool reverse) {
+	int result;
+
+	if ((0 <= bounds->start_used) && (0 > collate_subsarrays(subsarray, subs_used, bounds->start, bounds->start_used)))
+		return reverse ? YDBPython_ScanEnd : YDBPython_ScanSkip;
+	if ((0 <= bounds->stop_used) && (0 <= collate_subsarrays(subsarray, subs_used, bounds->stop, bounds->stop_used)))
+		return reverse ? YDBPython_ScanSkip : YDBPython_ScanEnd;
+	if (0 <= bounds->prefix_used) {
+		if ((bounds->prefix_used <= subs_used)
+		    && (0 == collate_subsarrays(subsarray, bounds->prefix_used, bounds->prefix, bounds->prefix_used)))
+			return YDBPython_ScanMatch;
+		result = collate_subsarrays(subsarray, subs_used, bounds->prefix, bounds->prefix_used);
+		if (reverse)
+			return (0 > result) ? YDBPython_ScanEnd : YDBPython_ScanSkip;
+		return (0 < result) ? YDBPython_ScanEnd : YDBPython_ScanSkip;
+	}
+	return YDBPython_ScanMatch;
+}
+
+/* Convert the optional `start`, `stop` and `prefix` arguments of subscript_scan() to a YDBSubscriptBounds
+ * struct. Boundaries that are None are left with a NULL buf_addr. On failure, an exception is raised and
+ * any buffers already allocated are freed. The buffers should otherwise be freed with free_subscript_bounds().
+ */
+static int populate_subscript_bounds(PyObject *start, PyObject *stop, PyObject *prefix, YDBSubscriptBounds *bounds) {
+	int	     status;
+	unsigned int i;
+
+	bounds->start.buf_addr = NULL;
+	bounds->stop.buf_addr = NULL;
+	bounds->prefix.buf_addr = NULL;
+	bounds->prefix_may_be_number = FALSE;
+	status = YDB_OK;
+	if (Py_None != start)
+		status = anystr_to_buffer(start, &bounds->start, FALSE);
+	if ((YDB_OK == status) && (Py_None != stop))
+		status = anystr_to_buffer(stop, &bounds->stop, FALSE);
+	if ((YDB_OK == status) && (Py_None != prefix))
+		status = anystr_to_buffer(prefix, &bounds->prefix, FALSE);
+	if (YDB_OK != status) {
+		YDB_FREE_BUFFER(&bounds->start);
+		YDB_FREE_BUFFER(&bounds->stop);
+		YDB_FREE_BUFFER(&bounds->prefix);
+		return status;
+	}
+	if (NULL != bounds->prefix.buf_addr) {
+		/* Canonical numbers consist only of the below characters, so a prefix with any other character
+		 * can only match strings, which collate contiguously.
+		 */
+		bounds->prefix_may_be_number = TRUE;
+		for (i = 0; i < bounds->prefix.len_used; i++) {
+			if (NULL == strchr(YDBPY_SCAN_PREFIX_NUMBER_CHARS, bounds->prefix.buf_addr[i])) {
+				bounds->prefix_may_be_number = FALSE;
+				break;
+			}
+		}
+	}
+	return YDB_OK;
+}
+
+static void free_subscript_bounds(YDBSubscriptBounds *bounds) {
+	YDB_FREE_BUFFER(&bounds->start);
+	YDB_FREE_BUFFER(&bounds->stop);
+	YDB_FREE_BUFFER(&bounds->prefix);
+}
+
+/* Convert the optional `start`, `stop` and `prefix` arguments of node_scan() to a YDBNodeBounds struct.
+ * Boundaries that are None are given a subs_used of -1. The arguments must have been validated with
+ * RETURN_IF_INVALID_SEQUENCE. The arrays should be freed with free_node_bounds().
+ */
+static int populate_node_bounds(PyObject *start, PyObject *stop, PyObject *prefix, YDBNodeBounds *bounds) {
+	bounds->start_used = bounds->stop_used = bounds->prefix_used = -1;
+	bounds->start = bounds->stop = bounds->prefix = NULL;
+	/* populate_subs_used_and_subsarray() frees the array on failure, so it is reset to prevent a double free */
+	if ((Py_None != start) && (YDB_OK != populate_subs_used_and_subsarray(start, &bounds->start_used, &bounds->start))) {
+		bounds->start = NULL;
+		return !YDB_OK;
+	}
+	if ((Py_None != stop) && (YDB_OK != populate_subs_used_and_subsarray(stop, &bounds->stop_used, &bounds->stop))) {
+		bounds->stop = NULL;
+		return !YDB_OK;
+	}
+	if ((Py_None != prefix) && (YDB_OK != populate_subs_used_and_subsarray(prefix, &bounds->prefix_used, &bounds->prefix))) {
+		bounds->prefix = NULL;
+		return !YDB_OK;
+	}
+	return YDB_OK;
+}
+
+static void free_node_bounds(YDBNodeBounds *bounds) {
+	FREE_BUFFER_ARRAY(bounds->start, bounds->start_used);
+	FREE_BUFFER_ARRAY(bounds->stop, bounds->stop_used);
+	FREE_BUFFER_ARRAY(bounds->prefix, bounds->prefix_used);
+}
+
+/* Call ydb_subscript_next_s(), or ydb_subscript_previous_s() if `reverse` is set, reallocating
+ * `ret_value` and calling the function again if `ret_value` is too small for the result.
+ */
+static int subscript_next_or_previous(ydb_buffer_t *varname, int subs_used, ydb_buffer_t *subsarray, ydb_buffer_t *ret_value,
+				      bool reverse) {
+	int status;
+
+	if (reverse)
+		status = ydb_subscript_previous_s(varname, subs_used, subsarray, ret_value);
+	else
+		status = ydb_subscript_next_s(varname, subs_used, subsarray, ret_value);
+	if (YDB_ERR_INVSTRLEN == status) {
+		FIX_BUFFER_LENGTH((*ret_value));
+		if (reverse)
+			status = ydb_subscript_previous_s(varname, subs_used, subsarray, ret_value);
+		else
+			status = ydb_subscript_next_s(varname, subs_used, subsarray, ret_value);
+		assert(YDB_ERR_INVSTRLEN != status);
+	}
+	return status;
+}
+
 /* Routine to help raise a YDBError. The caller still needs to return NULL for
  * the Exception to be raised.
  *
+ * A YDBError is created with the $ZSTATUS message and the error code as its arguments, so that
+ * `args[0]` is the message, as it always was. The other exceptions, which have no $ZSTATUS,
+ * are created with the error code as their only argument, and their message is only looked
+ * up with ydb_message() when the exception is converted to a string (see
+ * `YDBException.__str__()` in yottadb/__init__.py). This avoids the cost of formatting a
+ * message for frequent errors that are caught and discarded, e.g. YDB_ERR_NODEEND at the end
+ * of every iteration. In both cases, the error code is exposed as the `code` attribute.
+ *
  * Parameters:
  *    status                 - the error code that is returned by the wrapped ydb_ function.
  */
 static void raise_YDBError(int status) {
-	ydb_char_t   error_string[YDBPY_MAX_ERRORMSG];
-	ydb_buffer_t error_buffer;
-	PyObject *   error_type;
-	PyObject *   message;
-	int	     copied = 0, zstatus;
-	char	     full_error_message[YDBPY_MAX_ERRORMSG + CANONICAL_NUMBER_TO_STRING_MAX];
+	ydb_char_t error_string[YDBPY_MAX_ERRORMSG];
+	PyObject * error_type;
+	PyObject * error_args;
+	int	   zstatus;
 
 	/* YDB_ERR_NODEEND and errors in the YDB_DEFER_HANDLER to YDB_INT_MAX
-	 * range will not have a value stored in $ZSTATUS, so look up the
-	 * error message manually. In the cases of YDB_NOTOK and YDB_DEFER_HANDLER,
-	 * which have no valid error message and are not possible in YDBPython,
-	 * just use the error code number with no text description.
+	 * range are not errors in the strict sense and so are raised as specific
+	 * exception types. YDB_NOTOK and YDB_DEFER_HANDLER are not possible in
+	 * YDBPython, but are included for completeness.
 	 */
-	if ((YDB_ERR_TPTIMEOUT == status) || (YDB_ERR_NODEEND == status)
-	    || ((YDB_INT_MAX > status) && (YDB_DEFER_HANDLER <= status))) {
-		if ((YDB_ERR_TPTIMEOUT == status) || (YDB_ERR_NODEEND == status) || (YDB_LOCK_TIMEOUT == status)) {
-			error_buffer.buf_addr = error_string;
-			error_buffer.len_alloc = YDBPY_MAX_ERRORMSG;
-			error_buffer.len_used = 0;
-			zstatus = ydb_message(status, &error_buffer);
-			assert(YDB_OK == zstatus);
-			error_buffer.buf_addr[error_buffer.len_used] = '\0';
-		}
-
-		if (YDB_TP_ROLLBACK == status) {
-			copied = snprintf(full_error_message, YDBPY_MAX_ERRORMSG + CANONICAL_NUMBER_TO_STRING_MAX,
-					  "%d, %%YDB-TP-ROLLBACK: Transaction not committed.", status);
-			error_type = YDBTPRollback;
-		} else if (YDB_TP_RESTART == status) {
-			copied = snprintf(full_error_message, YDBPY_MAX_ERRORMSG + CANONICAL_NUMBER_TO_STRING_MAX,
-					  "%d, %%YDB-TP-RESTART: Restarting transaction.", status);
-			error_type = YDBTPRestart;
-		} else if (YDB_ERR_TPTIMEOUT == status) {
-			copied = snprintf(full_error_message, YDBPY_MAX_ERRORMSG + CANONICAL_NUMBER_TO_STRING_MAX, "%d, %s", status,
-					  error_string);
-			error_type = YDBTPTimeoutError;
-		} else if (YDB_NOTOK == status) {
-			copied = snprintf(full_error_message, YDBPY_MAX_ERRORMSG + CANONICAL_NUMBER_TO_STRING_MAX, "%d", status);
-			error_type = YDBNotOk;
-		} else if (YDB_LOCK_TIMEOUT == status) {
-			copied = snprintf(full_error_message, YDBPY_MAX_ERRORMSG + CANONICAL_NUMBER_TO_STRING_MAX, "%d, %s", status,
-					  error_string);
-			error_type = YDBLockTimeoutError;
-		} else if (YDB_DEFER_HANDLER == status) {
-			copied = snprintf(full_error_message, YDBPY_MAX_ERRORMSG + CANONICAL_NUMBER_TO_STRING_MAX, "%d", status);
-			error_type = YDBDeferHandler;
-		} else if (YDB_ERR_NODEEND == status) {
-			copied = snprintf(full_error_message, YDBPY_MAX_ERRORMSG + CANONICAL_NUMBER_TO_STRING_MAX, "%d, %s", status,
-					  error_string);
-			error_type = YDBNodeEnd;
-		} else {
-			assert(FALSE);
-		}
-	} else {
-		zstatus = ydb_zstatus(error_string, YDB_MAX_ERRORMSG);
+	switch (status) {
+	case YDB_TP_ROLLBACK:
+		error_type = module_state->YDBTPRollback;
+		break;
+	case YDB_TP_RESTART:
+		error_type = module_state->YDBTPRestart;
+		break;
+	case YDB_ERR_TPTIMEOUT:
+		error_type = module_state->YDBTPTimeoutError;
+		break;
+	case YDB_NOTOK:
+		error_type = module_state->YDBNotOk;
+		break;
+	case YDB_LOCK_TIMEOUT:
+		error_type = module_state->YDBLockTimeoutError;
+		break;
+	case YDB_DEFER_HANDLER:
+		error_type = module_state->YDBDeferHandler;
+		break;
+	case YDB_ERR_NODEEND:
+		error_type = module_state->YDBNodeEnd;
+		break;
+	default:
+		assert((YDB_INT_MAX <= status) || (YDB_DEFER_HANDLER > status));
+		error_type = module_state->YDBError;
+		break;
+	}
+	/* Only errors that set $ZSTATUS carry a message, which must be captured now, since $ZSTATUS is overwritten by any later
+	 * error, e.g. of another thread. The message of the other errors is derived from their code when it is first needed.
+	 */
+	error_args = NULL;
+	if (module_state->YDBError == error_type) {
+		zstatus = ydb_zstatus(error_string, YDBPY_MAX_ERRORMSG);
 		if ((YDB_OK == zstatus) || (YDB_ERR_INVSTRLEN == zstatus)) {
-			assert(NULL != error_string);
-			copied = snprintf(full_error_message, YDBPY_MAX_ERRORMSG, "%s", error_string);
-			error_type = YDBError;
-		} else {
-			assert(FALSE);
-			copied = snprintf(full_error_message, YDBPY_MAX_ERRORMSG, "%d, UNKNOWN error", status);
-			error_type = YDBError;
+			error_args = Py_BuildValue("(si)", error_string, status); // New Reference
+			// $ZSTATUS may contain bytes that are not valid UTF-8, e.g. from subscripts, so fall back to bytes
+			if (NULL == error_args) {
+				PyErr_Clear();
+				error_args = Py_BuildValue("(yi)", error_string, status); // New Reference
+			}
 		}
 	}
-
-	assert((0 <= copied) && (YDBPY_MAX_ERRORMSG > copied));
-	UNUSED(copied);
-	message = Py_BuildValue("s", full_error_message); // New Reference
-	
-	// Note that the below call to Py_BuildValue with a first argument of "y" is done in addition
-	// to the call above with "s" due to the reasoning at:
-	// https://gitlab.com/YottaDB/Lang/YDBPython/-/merge_requests/61#note_2283744959
-	if (NULL == message) {
-		message = Py_BuildValue("y", full_error_message); // New Reference
+	if (NULL == error_args) {
+		error_args = Py_BuildValue("(i)", status); // New Reference
+		if (NULL == error_args)
+			return;
 	}
-	RAISE_SPECIFIC_ERROR(error_type, message);
-	Py_DECREF(message);
+	RAISE_SPECIFIC_ERROR(error_type, error_args);
+	Py_DECREF(error_args);
 }
 
 /* API Wrappers */
@@ -929,50 +1332,53 @@ static void raise_YDBError(int status) {
 /* Initialize a py_ci_name_descriptor struct with the name of a call-in routine.
  * Used by cip() to prepare for a YottaDB call-in.
  */
-static int set_routine_name(char *routine_name) {
+static int set_routine_name(py_ci_name_descriptor *ci_info, char *routine_name) {
 	assert(NULL != routine_name);
-	ci_info.ci_info.rtn_name.length = strnlen(routine_name, YDB_MAX_IDENT);
-	if (0 >= ci_info.ci_info.rtn_name.length) {
-		PyErr_Format(YDBPythonError, "Failed to initialize call-in information for routine: %s", routine_name);
+	ci_info->ci_info.rtn_name.length = strnlen(routine_name, YDB_MAX_IDENT);
+	if (0 >= ci_info->ci_info.rtn_name.length) {
+		PyErr_Format(module_state->YDBPythonError, "Failed to initialize call-in information for routine: %s",
+			     routine_name);
 		return !YDB_OK;
 	}
-	ci_info.ci_info.rtn_name.length++; // Null terminator
-	if (NULL != ci_info.ci_info.rtn_name.address) {
-		free(ci_info.ci_info.rtn_name.address);
+	ci_info->ci_info.rtn_name.length++; // Null terminator
+	if (NULL != ci_info->ci_info.rtn_name.address) {
+		free(ci_info->ci_info.rtn_name.address);
 	}
-	ci_info.ci_info.rtn_name.address = malloc((ci_info.ci_info.rtn_name.length) * sizeof(char));
-	memcpy(ci_info.ci_info.rtn_name.address, routine_name, ci_info.ci_info.rtn_name.length);
-	ci_info.ci_info.handle = NULL;
-	ci_info.has_parm_types = FALSE;
+	ci_info->ci_info.rtn_name.address = malloc((ci_info->ci_info.rtn_name.length) * sizeof(char));
+	memcpy(ci_info->ci_info.rtn_name.address, routine_name, ci_info->ci_info.rtn_name.length);
+	ci_info->ci_info.handle = NULL;
+	ci_info->has_parm_types = FALSE;
 	return YDB_OK;
 }
 
 /* Cleans up a ci_name_descriptor struct by freeing memory and resetting
- * member values of the global ci_info struct.
+ * member values of the ci_info struct of the module state.
  */
-static void free_ci_name_descriptor() {
-	if (NULL != ci_info.ci_info.rtn_name.address) {
-		free(ci_info.ci_info.rtn_name.address);
-		ci_info.ci_info.rtn_name.address = NULL;
+static void free_ci_name_descriptor(py_ci_name_descriptor *ci_info) {
+	if (NULL != ci_info->ci_info.rtn_name.address) {
+		free(ci_info->ci_info.rtn_name.address);
+		ci_info->ci_info.rtn_name.address = NULL;
 	}
-	ci_info.ci_info.rtn_name.length = 0;
-	ci_info.ci_info.handle = NULL;
-	ci_info.has_parm_types = FALSE;
+	ci_info->ci_info.rtn_name.length = 0;
+	ci_info->ci_info.handle = NULL;
+	ci_info->has_parm_types = FALSE;
 }
 
 static PyObject *ci_wrapper(PyObject *args, PyObject *kwds, bool is_cip) {
-	bool	      return_null = false;
-	int	      status, has_retval;
-	PyObject *    routine, *routine_args, *seq, *py_arg, *ret;
-	unsigned int  inmask, outmask, io_args, num_args, cur_index, cur_arg;
-	ydb_buffer_t  routine_name;
-	ydb_string_t *args_ydb;
-	ydb_string_t  ret_val;
-	gparam_list   arg_values;
-	ci_parm_type  parm_types;
+	bool		       return_null = false;
+	int		       status, has_retval;
+	PyObject *	       routine, *routine_args, *seq, *py_arg, *ret;
+	unsigned int	       inmask, outmask, io_args, num_args, cur_index, cur_arg;
+	ydb_buffer_t	       routine_name;
+	ydb_string_t *	       args_ydb;
+	ydb_string_t	       ret_val;
+	gparam_list	       arg_values;
+	ci_parm_type	       parm_types;
+	py_ci_name_descriptor *ci_info;
 
 	seq = routine_args = NULL;
 	has_retval = FALSE;
+	ci_info = &module_state->ci_info;
 	ret = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
 
 	// Parse and validate
@@ -1001,23 +1407,23 @@ static PyObject *ci_wrapper(PyObject *args, PyObject *kwds, bool is_cip) {
 	 * a different routine name is used on a subsequent call.
 	 */
 	if (is_cip) {
-		if ((!ci_info.has_parm_types) || (NULL == ci_info.routine_name)
-		    || (!strncmp(ci_info.routine_name, routine_name.buf_addr, YDB_MAX_IDENT))) {
-			free_ci_name_descriptor();
-			status = set_routine_name(routine_name.buf_addr);
+		if ((!ci_info->has_parm_types) || (NULL == ci_info->routine_name)
+		    || (!strncmp(ci_info->routine_name, routine_name.buf_addr, YDB_MAX_IDENT))) {
+			free_ci_name_descriptor(ci_info);
+			status = set_routine_name(ci_info, routine_name.buf_addr);
 			if (YDB_OK != status) {
 				YDB_FREE_BUFFER(&routine_name);
 				return NULL;
 			}
-			status = ydb_ci_get_info(routine_name.buf_addr, &ci_info.parm_types);
+			status = ydb_ci_get_info(routine_name.buf_addr, &ci_info->parm_types);
 			if (YDB_OK != status) {
 				raise_YDBError(status);
 				YDB_FREE_BUFFER(&routine_name);
 				return NULL;
 			}
-			ci_info.has_parm_types = TRUE;
+			ci_info->has_parm_types = TRUE;
 		}
-		parm_types = ci_info.parm_types;
+		parm_types = ci_info->parm_types;
 	} else {
 		status = ydb_ci_get_info(routine_name.buf_addr, &parm_types);
 		if (YDB_OK != status) {
@@ -1142,7 +1548,7 @@ static PyObject *ci_wrapper(PyObject *args, PyObject *kwds, bool is_cip) {
 	// Populate array of variadic arguments for function call
 	cur_index = 0;
 	if (is_cip) {
-		arg_values.arg[cur_index] = &ci_info.ci_info;
+		arg_values.arg[cur_index] = &ci_info->ci_info;
 	} else {
 		arg_values.arg[cur_index] = routine_name.buf_addr;
 	}
@@ -1345,6 +1751,77 @@ static PyObject *adjust_stdout_stderr(PyObject *self) {
 	return Py_None;
 }
 
+/* Wrapper for ydb_child_init(). Must be called in a child process created by fork() before it uses YottaDB,
+ * e.g. by a process started by the Python multiprocessing module with the "fork" start method. It is not serialized,
+ * since it reinitializes api_lock, which may have been held by another thread of the parent process. Since the calling
+ * thread is the only thread of the child process, it sets module_state without holding api_lock.
+ */
+static PyObject *child_init(PyObject *self) {
+	int status;
+
+	init_api_lock();
+	module_state = PyModule_GetState(self);
+	status = ydb_child_init(NULL);
+	if (YDB_OK != status) {
+		raise_YDBError(status);
+		return NULL;
+	}
+
+	Py_INCREF(Py_None);
+	return Py_None;
+}
+
+/* Wrapper for ydb_zstatus(). Used to lazily look up the message text of a YDBError
+ * when the exception is converted to a string.
+ */
+static PyObject *zstatus(PyObject *self) {
+	ydb_char_t error_string[YDBPY_MAX_ERRORMSG];
+	PyObject * ret;
+	int	   status;
+
+	UNUSED(self);
+
+	status = ydb_zstatus(error_string, YDBPY_MAX_ERRORMSG);
+	/* A truncated message is still a valid (null-terminated) message */
+	if ((YDB_OK != status) && (YDB_ERR_INVSTRLEN != status)) {
+		raise_YDBError(status);
+		return NULL;
+	}
+	ret = Py_BuildValue("s", error_string); // New Reference
+	// $ZSTATUS may contain bytes that are not valid UTF-8, e.g. from a non-UTF-8 variable name or value.
+	// In that case, return the message as a bytes object instead of failing.
+	if (NULL == ret) {
+		PyErr_Clear();
+		ret = Py_BuildValue("y", error_string); // New Reference
+	}
+	return ret;
+}
+
+/* Returns the number of ASCII str objects, which need no encoding, and of other str objects, which may need to be encoded
+ * if their UTF-8 encoding is not cached yet, converted to buffers in the calling interpreter, i.e. the hits and potential
+ * misses of the cache. If reset is true, the counters are then reset.
+ */
+static PyObject *utf8_cache_stats(PyObject *self, PyObject *args, PyObject *kwds) {
+	PyObject *ret;
+	int	  reset;
+
+	UNUSED(self);
+	/* Default values for optional arguments passed from Python */
+	reset = FALSE;
+
+	/* Parse */
+	static char *kwlist[] = {"reset", NULL};
+	/* Parsed values are borrowed references, do not Py_DECREF them. */
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "|p", kwlist, &reset)) {
+		return NULL;
+	}
+	ret = Py_BuildValue("{s:K,s:K}", "hits", module_state->utf8_cache_hits, "misses", module_state->utf8_cache_misses);
+	if (reset) {
+		module_state->utf8_cache_hits = module_state->utf8_cache_misses = 0;
+	}
+	return ret;
+}
+
 /* Wrapper for ydb_data_s */
 static PyObject *data(PyObject *self, PyObject *args, PyObject *kwds) {
 	PyObject *    varname_py;
@@ -1477,36 +1954,347 @@ static PyObject *delete_except(PyObject *self, PyObject *args, PyObject *kwds) {
 	return ret;
 }
 
-/* Wrapper for ydb_get_s() */
-static PyObject *get(PyObject *self, PyObject *args, PyObject *kwds) {
-	int	      subs_used, status;
-	PyObject *    varname_py;
-	PyObject *    subsarray_py, *ret;
-	ydb_buffer_t  varname_ydb, ret_value;
-	ydb_buffer_t *subsarray_ydb;
+/* Move a traversal of the subtree of the node `subsarray` to the next node with a value after the node in `*node`, or to
+ * the node in `*node` itself if `candidate` is set, and get its value into `value`. The arrays in `*node` and `*next`
+ * are swapped after each call to ydb_node_next_s() as in the other traversals. `*in_subtree` is cleared when there are
+ * no more nodes with a value in the subtree. Returns YDB_OK or the status of a failed call.
+ */
+static int next_node_in_subtree(ydb_buffer_t *varname, int subs_used, ydb_buffer_t *subsarray, ydb_buffer_t **node,
+				ydb_buffer_t **next, int *node_used, ydb_buffer_t *value, bool candidate, bool *in_subtree) {
+	int	      next_used, status;
+	ydb_buffer_t *swap;
+
+	*in_subtree = FALSE;
+	status = YDB_OK;
+	while (YDB_OK == status) {
+		if (!candidate) {
+			next_used = YDB_MAX_SUBS;
+			status = ydb_node_next_s(varname, *node_used, *node, &next_used, *next);
+			/* If a buffer is not long enough */
+			while (YDB_ERR_INVSTRLEN == status) {
+				FIX_BUFFER_LENGTH((*next)[next_used]);
+				next_used = YDB_MAX_SUBS;
+				status = ydb_node_next_s(varname, *node_used, *node, &next_used, *next);
+			}
+			if (YDB_OK != status)
+				break;
+			swap = *node;
+			*node = *next;
+			*next = swap;
+			*node_used = next_used;
+		}
+		candidate = FALSE;
+		if ((*node_used < subs_used) || (0 != collate_subsarrays(*node, subs_used, subsarray, subs_used)))
+			break;
+		status = ydb_get_s(varname, *node_used, *node, value);
+		/* Check to see if length of string was longer than the value buffer. If so, try again
+		 * with proper length */
+		if (YDB_ERR_INVSTRLEN == status) {
+			FIX_BUFFER_LENGTH((*value));
+			status = ydb_get_s(varname, *node_used, *node, value);
+			assert(YDB_ERR_INVSTRLEN != status);
+		}
+		if ((YDB_ERR_GVUNDEF == status) || (YDB_ERR_LVUNDEF == status)) {
+			/* The root of the subtree has no value, or the node was deleted, e.g. by another process */
+			status = YDB_OK;
+		} else if (YDB_OK == status) {
+			*in_subtree = TRUE;
+			break;
+		}
+	}
+	return (YDB_ERR_NODEEND == status) ? YDB_OK : status;
+}
+
+/* Compare the subtrees of two nodes by traversing both with ydb_node_next_s() at once, as a merge join. Since both
+ * traversals return nodes in collation order, each node is compared with the corresponding node of the other subtree,
+ * if any, without holding either subtree in memory. Returns a list of (subscripts, kind, a_value, b_value) tuples for at
+ * most `count` differences (or all of them if `count` is 0), where the subscripts are relative to the compared nodes and
+ * `kind` is "removed" for a node with a value only in the subtree of `a`, "added" for a node with a value only in the
+ * subtree of `b`, or "changed" for a node with different values in each. The value of a node missing from either subtree
+ * is None.
+ *
+ * The comparison starts after the relative subscripts `cursor`, or at the compared nodes themselves if `cursor` is None.
+ * Returns a tuple of the list and the relative subscripts of the last difference, which can be passed as `cursor` to
+ * continue the comparison, or None if the comparison is complete. Both subtrees are assumed to use M standard collation.
+ */
+static PyObject *diff(PyObject *self, PyObject *args, PyObject *kwds) {
+	int	      count, found, order, status, i;
+	int	      a_subs_used, b_subs_used, cursor_used, a_node_used, b_node_used;
+	bool	      candidate, done, a_in_subtree, b_in_subtree;
+	PyObject *    a_varname_py, *a_subsarray_py, *b_varname_py, *b_subsarray_py, *cursor_py;
+	PyObject *    node_py, *a_value_py, *b_value_py, *item, *resume_py, *list, *ret;
+	ydb_buffer_t  a_varname_ydb, b_varname_ydb, a_value, b_value;
+	ydb_buffer_t *a_subsarray_ydb, *b_subsarray_ydb, *cursor_ydb, *a_node, *a_next, *b_node, *b_next;
+	const char *  kind;
 
 	UNUSED(self);
-	ret = NULL;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
-	subs_used = 0;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
-	subsarray_ydb = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	a_subs_used = 0;	// Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	a_subsarray_ydb = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
 	/* Default values for optional arguments passed from Python */
-	subsarray_py = Py_None;
+	cursor_py = Py_None;
+	count = 0;
 
-	/* Parse */
-	static char *kwlist[] = {"varname", "subsarray", NULL};
+	/* Parse and validate */
+	static char *kwlist[] = {"a_varname", "a_subsarray", "b_varname", "b_subsarray", "cursor", "count", NULL};
 	/* Parsed values are borrowed references, do not Py_DECREF them. */
-	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &varname_py, &subsarray_py))
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOOO|Oi", kwlist, &a_varname_py, &a_subsarray_py, &b_varname_py,
+					 &b_subsarray_py, &cursor_py, &count))
 		return NULL;
-	/* Validate */
-	RETURN_IF_INVALID_SEQUENCE(subsarray_py, YDBPython_SubsarraySequence);
+	RETURN_IF_INVALID_SEQUENCE(a_subsarray_py, YDBPython_SubsarraySequence);
+	RETURN_IF_INVALID_SEQUENCE(b_subsarray_py, YDBPython_SubsarraySequence);
+	RETURN_IF_INVALID_SEQUENCE(cursor_py, YDBPython_SubsarraySequence);
+	if (0 > count) {
+		PyErr_SetString(PyExc_ValueError, "'count' must be a non-negative int");
+		return NULL;
+	}
 
 	/* Setup for call */
-	INVOKE_ANYSTR_TO_BUFFER(varname_py, varname_ydb, TRUE);
-	INVOKE_POPULATE_SUBS_USED_AND_SUBSARRAY_AND_CLEANUP_VARNAME(subsarray_py, subs_used, subsarray_ydb, varname_ydb);
-	YDB_MALLOC_BUFFER(&ret_value, YDBPY_DEFAULT_VALUE_LEN);
-
-	/* Call the wrapped function */
-	status = ydb_get_s(&varname_ydb, subs_used, subsarray_ydb, &ret_value);
+	INVOKE_ANYSTR_TO_BUFFER(a_varname_py, a_varname_ydb, TRUE);
+	INVOKE_POPULATE_SUBS_USED_AND_SUBSARRAY_AND_CLEANUP_VARNAME(a_subsarray_py, a_subs_used, a_subsarray_ydb, a_varname_ydb);
+	if (YDB_OK != anystr_to_buffer(b_varname_py, &b_varname_ydb, TRUE)) {
+		FREE_BUFFER_ARRAY(a_subsarray_ydb, a_subs_used);
+		YDB_FREE_BUFFER(&a_varname_ydb);
+		return NULL;
+	}
+	if (YDB_OK != populate_subs_used_and_subsarray(b_subsarray_py, &b_subs_used, &b_subsarray_ydb)) {
+		FREE_BUFFER_ARRAY(a_subsarray_ydb, a_subs_used);
+		YDB_FREE_BUFFER(&a_varname_ydb);
+		YDB_FREE_BUFFER(&b_varname_ydb);
+		return NULL;
+	}
+	cursor_ydb = NULL;
+	cursor_used = 0;
+	if ((Py_None != cursor_py) && (YDB_OK != populate_subs_used_and_subsarray(cursor_py, &cursor_used, &cursor_ydb))) {
+		FREE_BUFFER_ARRAY(a_subsarray_ydb, a_subs_used);
+		FREE_BUFFER_ARRAY(b_subsarray_ydb, b_subs_used);
+		YDB_FREE_BUFFER(&a_varname_ydb);
+		YDB_FREE_BUFFER(&b_varname_ydb);
+		return NULL;
+	}
+	/* Use two arrays with room for the maximum number of subscripts for each side, for the current node and the node
+	 * returned by ydb_node_next_s(), and swap them after each call to avoid copying subscripts. Each side starts at its
+	 * compared node followed by the cursor, if any.
+	 */
+	a_node = create_empty_buffer_array(YDB_MAX_SUBS, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+	a_next = create_empty_buffer_array(YDB_MAX_SUBS, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+	b_node = create_empty_buffer_array(YDB_MAX_SUBS, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+	b_next = create_empty_buffer_array(YDB_MAX_SUBS, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+	a_node_used = a_subs_used + cursor_used;
+	b_node_used = b_subs_used + cursor_used;
+	status = ((YDB_MAX_SUBS < a_node_used) || (YDB_MAX_SUBS < b_node_used)) ? YDB_ERR_MAXNRSUBSCRIPTS : YDB_OK;
+	if (YDB_OK == status) {
+		for (i = 0; i < a_subs_used; i++)
+			copy_buffer(&a_node[i], &a_subsarray_ydb[i]);
+		for (i = 0; i < b_subs_used; i++)
+			copy_buffer(&b_node[i], &b_subsarray_ydb[i]);
+		for (i = 0; i < cursor_used; i++) {
+			copy_buffer(&a_node[a_subs_used + i], &cursor_ydb[i]);
+			copy_buffer(&b_node[b_subs_used + i], &cursor_ydb[i]);
+		}
+	}
+	FREE_BUFFER_ARRAY(cursor_ydb, cursor_used);
+	YDB_MALLOC_BUFFER(&a_value, YDBPY_DEFAULT_VALUE_LEN);
+	YDB_MALLOC_BUFFER(&b_value, YDBPY_DEFAULT_VALUE_LEN);
+
+	/* Call the wrapped functions until the traversals of both subtrees are complete */
+	list = PyList_New(0); // New Reference
+	resume_py = NULL;
+	found = 0;
+	/* The compared nodes themselves are only included if the comparison starts there */
+	candidate = (Py_None == cursor_py);
+	a_in_subtree = b_in_subtree = FALSE;
+	if (YDB_OK == status)
+		status = next_node_in_subtree(&a_varname_ydb, a_subs_used, a_subsarray_ydb, &a_node, &a_next, &a_node_used,
+					      &a_value, candidate, &a_in_subtree);
+	if (YDB_OK == status)
+		status = next_node_in_subtree(&b_varname_ydb, b_subs_used, b_subsarray_ydb, &b_node, &b_next, &b_node_used,
+					      &b_value, candidate, &b_in_subtree);
+	done = (NULL == list);
+	while (!done && (YDB_OK == status) && (a_in_subtree || b_in_subtree)) {
+		/* A side with no more nodes collates after all nodes of the other side */
+		if (a_in_subtree && b_in_subtree)
+			order = collate_subsarrays(&a_node[a_subs_used], a_node_used - a_subs_used, &b_node[b_subs_used],
+						   b_node_used - b_subs_used);
+		else
+			order = a_in_subtree ? -1 : 1;
+		kind = NULL;
+		if (0 > order) {
+			kind = "removed";
+		} else if (0 < order) {
+			kind = "added";
+		} else if (0 != compare_bytes(a_value.buf_addr, a_value.len_used, b_value.buf_addr, b_value.len_used)) {
+			kind = "changed";
+		}
+		if (NULL != kind) {
+			if (0 < order) {
+				node_py = convert_ydb_buffer_array_to_py_tuple(&b_node[b_subs_used], b_node_used - b_subs_used);
+				Py_INCREF(Py_None);
+				a_value_py = Py_None;
+			} else {
+				node_py = convert_ydb_buffer_array_to_py_tuple(&a_node[a_subs_used], a_node_used - a_subs_used);
+				a_value_py = PyBytes_FromStringAndSize(a_value.buf_addr, a_value.len_used); // New Reference
+			}
+			if (0 > order) {
+				Py_INCREF(Py_None);
+				b_value_py = Py_None;
+			} else {
+				b_value_py = PyBytes_FromStringAndSize(b_value.buf_addr, b_value.len_used); // New Reference
+			}
+			if ((NULL == node_py) || (NULL == a_value_py) || (NULL == b_value_py)) {
+				Py_XDECREF(node_py);
+				Py_XDECREF(a_value_py);
+				Py_XDECREF(b_value_py);
+				Py_CLEAR(list);
+				break;
+			}
+			/* Steal the references to a_value_py and b_value_py, but not to node_py, which is kept below */
+			item = Py_BuildValue("(OsNN)", node_py, kind, a_value_py, b_value_py);
+			if ((NULL == item) || (0 != PyList_Append(list, item))) {
+				Py_XDECREF(item);
+				Py_DECREF(node_py);
+				Py_CLEAR(list);
+				break;
+			}
+			Py_DECREF(item);
+			/* Keep the subscripts of the last difference, in case the comparison is continued from there */
+			Py_XDECREF(resume_py);
+			resume_py = node_py;
+			found++;
+			done = (found == count);
+		}
+		/* Advance the side or sides with the first node */
+		if (0 >= order)
+			status = next_node_in_subtree(&a_varname_ydb, a_subs_used, a_subsarray_ydb, &a_node, &a_next, &a_node_used,
+						      &a_value, FALSE, &a_in_subtree);
+		if ((YDB_OK == status) && (0 <= order))
+			status = next_node_in_subtree(&b_varname_ydb, b_subs_used, b_subsarray_ydb, &b_node, &b_next, &b_node_used,
+						      &b_value, FALSE, &b_in_subtree);
+	}
+	FREE_BUFFER_ARRAY(a_subsarray_ydb, a_subs_used);
+	FREE_BUFFER_ARRAY(b_subsarray_ydb, b_subs_used);
+	FREE_BUFFER_ARRAY(a_node, YDB_MAX_SUBS);
+	FREE_BUFFER_ARRAY(a_next, YDB_MAX_SUBS);
+	FREE_BUFFER_ARRAY(b_node, YDB_MAX_SUBS);
+	FREE_BUFFER_ARRAY(b_next, YDB_MAX_SUBS);
+	YDB_FREE_BUFFER(&a_varname_ydb);
+	YDB_FREE_BUFFER(&b_varname_ydb);
+	YDB_FREE_BUFFER(&a_value);
+	YDB_FREE_BUFFER(&b_value);
+
+	if ((YDB_OK != status) || (NULL == list)) {
+		Py_XDECREF(resume_py);
+		Py_XDECREF(list);
+		if (YDB_OK != status)
+			raise_YDBError(status);
+		return NULL;
+	}
+	if (!done) {
+		Py_XDECREF(resume_py);
+		Py_INCREF(Py_None);
+		resume_py = Py_None;
+	}
+	/* Steal the references to list and resume_py */
+	ret = Py_BuildValue("(NN)", list, resume_py);
+	return ret;
+}
+
+/* Combined wrapper for ydb_data_s() and ydb_get_s(). Returns a tuple of the form (data_status, value),
+ * where value is None if the node has no value. The value is only retrieved with ydb_get_s() if
+ * ydb_data_s() reports that the node has one, so a node without a value costs a single call.
+ */
+static PyObject *fetch(PyObject *self, PyObject *args, PyObject *kwds) {
+	int	      subs_used, status;
+	unsigned int  data_status;
+	PyObject *    varname_py;
+	PyObject *    subsarray_py, *ret;
+	ydb_buffer_t  varname_ydb, ret_value;
+	ydb_buffer_t *subsarray_ydb;
+
+	UNUSED(self);
+	ret = NULL;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	subs_used = 0;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	subsarray_ydb = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	/* Default values for optional arguments passed from Python */
+	subsarray_py = Py_None;
+
+	/* Parse */
+	static char *kwlist[] = {"varname", "subsarray", NULL};
+	/* Parsed values are borrowed references, do not Py_DECREF them. */
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &varname_py, &subsarray_py))
+		return NULL;
+	/* Validate */
+	RETURN_IF_INVALID_SEQUENCE(subsarray_py, YDBPython_SubsarraySequence);
+
+	/* Setup for call */
+	INVOKE_ANYSTR_TO_BUFFER(varname_py, varname_ydb, TRUE);
+	INVOKE_POPULATE_SUBS_USED_AND_SUBSARRAY_AND_CLEANUP_VARNAME(subsarray_py, subs_used, subsarray_ydb, varname_ydb);
+
+	/* Call the wrapped functions */
+	status = ydb_data_s(&varname_ydb, subs_used, subsarray_ydb, &data_status);
+	if ((YDB_OK == status) && ((YDB_DATA_VALUE_NODESC == data_status) || (YDB_DATA_VALUE_DESC == data_status))) {
+		YDB_MALLOC_BUFFER(&ret_value, YDBPY_DEFAULT_VALUE_LEN);
+		status = ydb_get_s(&varname_ydb, subs_used, subsarray_ydb, &ret_value);
+		/* Check to see if length of string was longer than YDBPY_DEFAULT_VALUE_LEN. If so, try again
+		 * with proper length */
+		if (YDB_ERR_INVSTRLEN == status) {
+			FIX_BUFFER_LENGTH(ret_value);
+			status = ydb_get_s(&varname_ydb, subs_used, subsarray_ydb, &ret_value);
+			assert(YDB_ERR_INVSTRLEN != status);
+		}
+		if (YDB_OK == status) {
+			/* New Reference */
+			ret = Py_BuildValue("(Iy#)", data_status, ret_value.buf_addr, (Py_ssize_t)ret_value.len_used);
+		} else if ((YDB_ERR_GVUNDEF == status) || (YDB_ERR_LVUNDEF == status)) {
+			/* The value was deleted, e.g. by another process, between the two calls */
+			data_status = (YDB_DATA_VALUE_DESC == data_status) ? YDB_DATA_NOVALUE_DESC : YDB_DATA_UNDEF;
+			status = YDB_OK;
+		}
+		YDB_FREE_BUFFER(&ret_value);
+	}
+	FREE_BUFFER_ARRAY(subsarray_ydb, subs_used);
+	YDB_FREE_BUFFER(&varname_ydb);
+
+	if (YDB_OK != status) {
+		raise_YDBError(status);
+	} else if (NULL == ret) {
+		ret = Py_BuildValue("(IO)", data_status, Py_None); // New Reference
+	}
+	return ret;
+}
+
+/* Wrapper for ydb_get_s() */
+static PyObject *get(PyObject *self, PyObject *args, PyObject *kwds) {
+	int	      subs_used, status;
+	PyObject *    varname_py;
+	PyObject *    subsarray_py, *ret;
+	const char *  encoding, *errors;
+	ydb_buffer_t  varname_ydb, ret_value;
+	ydb_buffer_t *subsarray_ydb;
+
+	UNUSED(self);
+	ret = NULL;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	subs_used = 0;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	subsarray_ydb = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	/* Default values for optional arguments passed from Python */
+	subsarray_py = Py_None;
+	encoding = NULL;
+	errors = "strict";
+
+	/* Parse */
+	static char *kwlist[] = {"varname", "subsarray", "decode", "errors", NULL};
+	/* Parsed values are borrowed references, do not Py_DECREF them. */
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|Ozs", kwlist, &varname_py, &subsarray_py, &encoding, &errors))
+		return NULL;
+	/* Validate */
+	RETURN_IF_INVALID_SEQUENCE(subsarray_py, YDBPython_SubsarraySequence);
+
+	/* Setup for call */
+	INVOKE_ANYSTR_TO_BUFFER(varname_py, varname_ydb, TRUE);
+	INVOKE_POPULATE_SUBS_USED_AND_SUBSARRAY_AND_CLEANUP_VARNAME(subsarray_py, subs_used, subsarray_ydb, varname_ydb);
+	YDB_MALLOC_BUFFER(&ret_value, YDBPY_DEFAULT_VALUE_LEN);
+
+	/* Call the wrapped function */
+	status = ydb_get_s(&varname_ydb, subs_used, subsarray_ydb, &ret_value);
 	/* Check to see if length of string was longer than YDBPY_DEFAULT_VALUE_LEN. If so, try again
 	 * with proper length */
 	if (YDB_ERR_INVSTRLEN == status) {
@@ -1519,18 +2307,85 @@ static PyObject *get(PyObject *self, PyObject *args, PyObject *kwds) {
 	YDB_FREE_BUFFER(&varname_ydb);
 	if (YDB_OK != status) {
 		if ((YDB_ERR_GVUNDEF == status) || (YDB_ERR_LVUNDEF == status)) {
-			return Py_None;
+			Py_INCREF(Py_None);
+			ret = Py_None;
 		} else
 			raise_YDBError(status);
 	} else {
 		/* Create Python object to return */
 		/* New Reference */
-		ret = Py_BuildValue("y#", ret_value.buf_addr, (Py_ssize_t)ret_value.len_used);
+		ret = new_object_from_buffer(&ret_value, encoding, errors);
 	}
 	YDB_FREE_BUFFER(&ret_value);
 	return ret;
 }
 
+/* Shared implementation of get_int() and get_float(). Retrieves the value of a node with ydb_get_s()
+ * and converts it to a Python number in C. Since any valid number fits in CANONICAL_NUMBER_TO_STRING_MAX
+ * bytes, the value is retrieved into a stack buffer and a YDB_ERR_INVSTRLEN return signals a non-numeric
+ * value rather than the need to retry with a larger buffer.
+ */
+static PyObject *get_number_wrapper(PyObject *args, PyObject *kwds, YDBPythonNumberType number_type) {
+	int	      subs_used, status;
+	PyObject *    varname_py;
+	PyObject *    subsarray_py, *ret;
+	ydb_buffer_t  varname_ydb, ret_value;
+	ydb_buffer_t *subsarray_ydb;
+	char	      number[CANONICAL_NUMBER_TO_STRING_MAX];
+
+	ret = NULL;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	subs_used = 0;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	subsarray_ydb = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	/* Default values for optional arguments passed from Python */
+	subsarray_py = Py_None;
+
+	/* Parse */
+	static char *kwlist[] = {"varname", "subsarray", NULL};
+	/* Parsed values are borrowed references, do not Py_DECREF them. */
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &varname_py, &subsarray_py))
+		return NULL;
+	/* Validate */
+	RETURN_IF_INVALID_SEQUENCE(subsarray_py, YDBPython_SubsarraySequence);
+
+	/* Setup for call */
+	INVOKE_ANYSTR_TO_BUFFER(varname_py, varname_ydb, TRUE);
+	INVOKE_POPULATE_SUBS_USED_AND_SUBSARRAY_AND_CLEANUP_VARNAME(subsarray_py, subs_used, subsarray_ydb, varname_ydb);
+	ret_value.buf_addr = number;
+	ret_value.len_alloc = CANONICAL_NUMBER_TO_STRING_MAX;
+	ret_value.len_used = 0;
+
+	/* Call the wrapped function */
+	status = ydb_get_s(&varname_ydb, subs_used, subsarray_ydb, &ret_value);
+	FREE_BUFFER_ARRAY(subsarray_ydb, subs_used);
+	YDB_FREE_BUFFER(&varname_ydb);
+	if (YDB_ERR_INVSTRLEN == status) {
+		// ret_value.len_used holds the actual length of the value, which is too long to be a number
+		ret = new_number_from_buffer(&ret_value, number_type);
+		assert(NULL == ret);
+	} else if ((YDB_ERR_GVUNDEF == status) || (YDB_ERR_LVUNDEF == status)) {
+		Py_INCREF(Py_None);
+		ret = Py_None;
+	} else if (YDB_OK != status) {
+		raise_YDBError(status);
+	} else {
+		/* Create Python object to return. Creates a new reference */
+		ret = new_number_from_buffer(&ret_value, number_type);
+	}
+	return ret;
+}
+
+/* Wrapper for ydb_get_s() returning a Python int */
+static PyObject *get_int(PyObject *self, PyObject *args, PyObject *kwds) {
+	UNUSED(self);
+	return get_number_wrapper(args, kwds, YDBPython_Integer);
+}
+
+/* Wrapper for ydb_get_s() returning a Python float */
+static PyObject *get_float(PyObject *self, PyObject *args, PyObject *kwds) {
+	UNUSED(self);
+	return get_number_wrapper(args, kwds, YDBPython_Float);
+}
+
 /* Wrapper for ydb_incr_s() */
 static PyObject *incr(PyObject *self, PyObject *args, PyObject *kwds) {
 	int	      status, subs_used;
@@ -1590,6 +2445,195 @@ static PyObject *incr(PyObject *self, PyObject *args, PyObject *kwds) {
 	return ret;
 }
 
+/* Wrapper for ydb_incr_s() accepting a Python int increment and returning a Python number.
+ * Both the increment and the new value are kept in stack buffers, since any canonical number
+ * fits in CANONICAL_NUMBER_TO_STRING_MAX bytes.
+ */
+static PyObject *incr_int(PyObject *self, PyObject *args, PyObject *kwds) {
+	int	      status, subs_used;
+	long long     increment;
+	PyObject *    varname_py, *increment_py;
+	PyObject *    subsarray_py, *ret;
+	ydb_buffer_t  increment_ydb, ret_value, varname_ydb;
+	ydb_buffer_t *subsarray_ydb;
+	char	      increment_str[CANONICAL_NUMBER_TO_STRING_MAX], number[CANONICAL_NUMBER_TO_STRING_MAX];
+
+	UNUSED(self);
+	ret = NULL;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	subs_used = 0;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	subsarray_ydb = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	/* Default values for optional arguments passed from Python */
+	subsarray_py = Py_None;
+	increment_py = Py_None;
+
+	/* Parse */
+	static char *kwlist[] = {"varname", "subsarray", "increment", NULL};
+	/* Parsed values are borrowed references, do not Py_DECREF them. */
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OO", kwlist, &varname_py, &subsarray_py, &increment_py)) {
+		return NULL;
+	}
+	/* Validate */
+	RETURN_IF_INVALID_SEQUENCE(subsarray_py, YDBPython_SubsarraySequence);
+	if (Py_None == increment_py) {
+		// No value was specified, or it was None, so increment by a default of 1.
+		increment = 1;
+	} else if (PyLong_Check(increment_py) && !PyBool_Check(increment_py)) {
+		increment = PyLong_AsLongLong(increment_py); // Raises OverflowError if Python int doesn't fit in C long long
+		if ((-1 == increment) && (NULL != PyErr_Occurred())) {
+			return NULL;
+		}
+	} else {
+		PyErr_SetString(PyExc_TypeError, "'increment' must be an int");
+		return NULL;
+	}
+
+	/* Setup for Call */
+	INVOKE_ANYSTR_TO_BUFFER(varname_py, varname_ydb, TRUE);
+	INVOKE_POPULATE_SUBS_USED_AND_SUBSARRAY_AND_CLEANUP_VARNAME(subsarray_py, subs_used, subsarray_ydb, varname_ydb);
+	increment_ydb.buf_addr = increment_str;
+	increment_ydb.len_alloc = CANONICAL_NUMBER_TO_STRING_MAX;
+	increment_ydb.len_used = snprintf(increment_str, CANONICAL_NUMBER_TO_STRING_MAX, "%lld", increment);
+	ret_value.buf_addr = number;
+	ret_value.len_alloc = CANONICAL_NUMBER_TO_STRING_MAX;
+	ret_value.len_used = 0;
+
+	/* Call the wrapped function */
+	status = ydb_incr_s(&varname_ydb, subs_used, subsarray_ydb, &increment_ydb, &ret_value);
+	FREE_BUFFER_ARRAY(subsarray_ydb, subs_used);
+	YDB_FREE_BUFFER(&varname_ydb);
+	assert(YDB_ERR_INVSTRLEN != status);
+	if (YDB_OK != status) {
+		raise_YDBError(status);
+	} else {
+		/* The node may have held a non-integer value before the increment, in which case
+		 * the new value is not an integer either. So, accept either type here rather than
+		 * raising an exception after the database was updated. Creates a new reference.
+		 */
+		ret = new_number_from_buffer(&ret_value, YDBPython_IntegerOrFloat);
+	}
+	return ret;
+}
+
+/* Return a list of (subscript, value) tuples, or (subscript, value, data) tuples if `data` is set, for at most `count`
+ * subscripts (or all of them if `count` is 0) following the last subscript in `subsarray` at the same level, as with
+ * repeated calls to subscript_next() and get() (and data()). The value of a node with no value is None. The subscript
+ * and value buffers are reused across iterations, so that the subscripts and values are only copied to Python objects.
+ * If `decode` is given, the values are decoded into str objects with it, while the subscripts are returned as bytes
+ * objects so that they can be passed back as `subsarray` to resume the iteration exactly.
+ */
+static PyObject *items(PyObject *self, PyObject *args, PyObject *kwds) {
+	int	      count, found, status, subs_used, with_data;
+	unsigned int  data_value;
+	PyObject *    varname_py, *subsarray_py;
+	PyObject *    value_py, *item, *ret;
+	const char *  encoding, *errors;
+	ydb_buffer_t  varname_ydb, next_value, swap, ret_value;
+	ydb_buffer_t *subsarray_ydb, *cursor;
+
+	UNUSED(self);
+	subs_used = 0;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	subsarray_ydb = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	/* Default values for optional arguments passed from Python */
+	subsarray_py = Py_None;
+	count = 0;
+	with_data = FALSE;
+	encoding = NULL;
+	errors = "strict";
+
+	/* Parse and validate */
+	static char *kwlist[] = {"varname", "subsarray", "count", "data", "decode", "errors", NULL};
+	/* Parsed values are borrowed references, do not Py_DECREF them. */
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|Oipzs", kwlist, &varname_py, &subsarray_py, &count, &with_data, &encoding,
+					 &errors))
+		return NULL;
+	RETURN_IF_INVALID_SEQUENCE(subsarray_py, YDBPython_SubsarraySequence);
+	if (0 > count) {
+		PyErr_SetString(PyExc_ValueError, "'count' must be a non-negative int");
+		return NULL;
+	}
+
+	/* Setup for call */
+	INVOKE_ANYSTR_TO_BUFFER(varname_py, varname_ydb, TRUE);
+	INVOKE_POPULATE_SUBS_USED_AND_SUBSARRAY_AND_CLEANUP_VARNAME(subsarray_py, subs_used, subsarray_ydb, varname_ydb);
+	YDB_MALLOC_BUFFER(&next_value, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+	YDB_MALLOC_BUFFER(&ret_value, YDBPY_DEFAULT_VALUE_LEN);
+	/* The iteration proceeds by replacing the last subscript, or the variable name if there are no subscripts */
+	cursor = (0 < subs_used) ? &subsarray_ydb[subs_used - 1] : &varname_ydb;
+
+	/* Call the wrapped functions */
+	ret = PyList_New(0); // New Reference
+	found = 0;
+	status = YDB_OK;
+	while ((NULL != ret) && ((0 == count) || (found < count))) {
+		status = subscript_next_or_previous(&varname_ydb, subs_used, subsarray_ydb, &next_value, FALSE);
+		if (YDB_OK != status)
+			break;
+		/* Use the returned subscript as the node to get, and reuse the buffer of the previous subscript
+		 * for the next subscript.
+		 */
+		swap = *cursor;
+		*cursor = next_value;
+		next_value = swap;
+		data_value = YDB_DATA_VALUE_NODESC;
+		if (with_data) {
+			status = ydb_data_s(&varname_ydb, subs_used, subsarray_ydb, &data_value);
+			if (YDB_OK != status)
+				break;
+		}
+		value_py = NULL;
+		if ((YDB_DATA_VALUE_NODESC == data_value) || (YDB_DATA_VALUE_DESC == data_value)) {
+			status = ydb_get_s(&varname_ydb, subs_used, subsarray_ydb, &ret_value);
+			/* Check to see if length of string was longer than the value buffer. If so, try again
+			 * with proper length */
+			if (YDB_ERR_INVSTRLEN == status) {
+				FIX_BUFFER_LENGTH(ret_value);
+				status = ydb_get_s(&varname_ydb, subs_used, subsarray_ydb, &ret_value);
+				assert(YDB_ERR_INVSTRLEN != status);
+			}
+			if (YDB_OK == status) {
+				value_py = new_object_from_buffer(&ret_value, encoding, errors); // New Reference
+				if (NULL == value_py) {
+					Py_CLEAR(ret);
+					break;
+				}
+			} else if ((YDB_ERR_GVUNDEF == status) || (YDB_ERR_LVUNDEF == status)) {
+				/* The node has descendants but no value, or the value was deleted after the call to ydb_data_s() */
+				if (with_data)
+					data_value = (YDB_DATA_VALUE_DESC == data_value) ? YDB_DATA_NOVALUE_DESC : YDB_DATA_UNDEF;
+				status = YDB_OK;
+			} else
+				break;
+		}
+		if (NULL == value_py) {
+			Py_INCREF(Py_None);
+			value_py = Py_None;
+		}
+		/* Steal the reference to value_py */
+		if (with_data)
+			item = Py_BuildValue("(y#NI)", cursor->buf_addr, (Py_ssize_t)cursor->len_used, value_py, data_value);
+		else
+			item = Py_BuildValue("(y#N)", cursor->buf_addr, (Py_ssize_t)cursor->len_used, value_py);
+		if ((NULL == item) || (0 != PyList_Append(ret, item))) {
+			Py_XDECREF(item);
+			Py_CLEAR(ret);
+			break;
+		}
+		Py_DECREF(item);
+		found++;
+	}
+	FREE_BUFFER_ARRAY(subsarray_ydb, subs_used);
+	YDB_FREE_BUFFER(&varname_ydb);
+	YDB_FREE_BUFFER(&next_value);
+	YDB_FREE_BUFFER(&ret_value);
+
+	if ((YDB_OK != status) && (YDB_ERR_NODEEND != status)) {
+		Py_XDECREF(ret);
+		raise_YDBError(status);
+		return NULL;
+	}
+	return ret;
+}
+
 /* Wrapper for ydb_lock_s() */
 static PyObject *lock(PyObject *self, PyObject *args, PyObject *kwds) {
 	bool		   return_null = false;
@@ -1654,7 +2698,8 @@ static PyObject *lock(PyObject *self, PyObject *args, PyObject *kwds) {
 		status = ydb_call_variadic_plist_func((ydb_vplist_func)&ydb_lock_s, &arg_values);
 		/* check for errors */
 		if (YDB_LOCK_TIMEOUT == status) {
-			PyErr_SetString(YDBLockTimeoutError, "Not able to acquire all requested locks in the specified time.");
+			PyErr_SetString(module_state->YDBLockTimeoutError,
+					"Not able to acquire all requested locks in the specified time.");
 			return_null = true;
 		} else if (YDB_OK != status) {
 			raise_YDBError(status);
@@ -1746,7 +2791,8 @@ static PyObject *lock_incr(PyObject *self, PyObject *args, PyObject *kwds) {
 	YDB_FREE_BUFFER(&varname_ydb);
 	FREE_BUFFER_ARRAY(subsarray_ydb, subs_used);
 	if (YDB_LOCK_TIMEOUT == status) {
-		PyErr_SetString(YDBLockTimeoutError, "Not able to acquire all requested locks in the specified time.");
+		PyErr_SetString(module_state->YDBLockTimeoutError,
+				"Not able to acquire all requested locks in the specified time.");
 	} else if (YDB_OK != status) {
 		raise_YDBError(status);
 	} else {
@@ -1756,28 +2802,712 @@ static PyObject *lock_incr(PyObject *self, PyObject *args, PyObject *kwds) {
 	return ret;
 }
 
-/* Wrapper for ydb_node_next_s() */
-static PyObject *node_next(PyObject *self, PyObject *args, PyObject *kwds) {
-	int	      max_subscript_string, ret_subsarray_num_elements, ret_subs_used, status, subs_used;
-	PyObject *    varname_py;
-	PyObject *    subsarray_py, *ret;
-	ydb_buffer_t  varname_ydb;
-	ydb_buffer_t *ret_subsarray, *subsarray_ydb;
+/* Copy the value of each node in the subtree of the source node to the corresponding node in the subtree of the destination
+ * node, as with the M MERGE command, by passing the values returned by ydb_get_s() for the nodes returned by ydb_node_next_s()
+ * directly to ydb_set_s(). If `overwrite` is not set, destination nodes that already have a value are left unchanged.
+ *
+ * At most `count` source nodes (or all of them if `count` is 0) are copied, starting after the source node `cursor`, or at
+ * the source node itself if `cursor` is None. Returns a tuple of the number of nodes set and the last source node copied,
+ * which can be passed as `cursor` to continue the merge, or None if the merge is complete.
+ */
+static PyObject *merge(PyObject *self, PyObject *args, PyObject *kwds) {
+	int	      count, copied, found, overwrite, node_used, next_used, status, i;
+	int	      src_subs_used, dst_subs_used, common_used;
+	unsigned int  data_value;
+	bool	      candidate, done;
+	PyObject *    src_varname_py, *src_subsarray_py, *dst_varname_py, *dst_subsarray_py, *cursor_py;
+	PyObject *    resume_py, *ret;
+	ydb_buffer_t  src_varname_ydb, dst_varname_ydb, ret_value;
+	ydb_buffer_t *src_subsarray_ydb, *dst_subsarray_ydb, *cursor_ydb, *node, *next, *swap, *target;
 
 	UNUSED(self);
-	ret = NULL;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
-	subs_used = 0;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
-	subsarray_ydb = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	src_subs_used = 0;	  // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	src_subsarray_ydb = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
 	/* Default values for optional arguments passed from Python */
-	subsarray_py = Py_None;
+	overwrite = TRUE;
+	cursor_py = Py_None;
+	count = 0;
 
 	/* Parse and validate */
-	static char *kwlist[] = {"varname", "subsarray", NULL};
+	static char *kwlist[]
+	    = {"src_varname", "src_subsarray", "dst_varname", "dst_subsarray", "overwrite", "cursor", "count", NULL};
 	/* Parsed values are borrowed references, do not Py_DECREF them. */
-	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &varname_py, &subsarray_py))
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOOO|pOi", kwlist, &src_varname_py, &src_subsarray_py, &dst_varname_py,
+					 &dst_subsarray_py, &overwrite, &cursor_py, &count))
 		return NULL;
-	RETURN_IF_INVALID_SEQUENCE(subsarray_py, YDBPython_SubsarraySequence);
-
+	RETURN_IF_INVALID_SEQUENCE(src_subsarray_py, YDBPython_SubsarraySequence);
+	RETURN_IF_INVALID_SEQUENCE(dst_subsarray_py, YDBPython_SubsarraySequence);
+	RETURN_IF_INVALID_SEQUENCE(cursor_py, YDBPython_SubsarraySequence);
+	if (0 > count) {
+		PyErr_SetString(PyExc_ValueError, "'count' must be a non-negative int");
+		return NULL;
+	}
+
+	/* Setup for call */
+	INVOKE_ANYSTR_TO_BUFFER(src_varname_py, src_varname_ydb, TRUE);
+	INVOKE_POPULATE_SUBS_USED_AND_SUBSARRAY_AND_CLEANUP_VARNAME(src_subsarray_py, src_subs_used, src_subsarray_ydb,
+								    src_varname_ydb);
+	if (YDB_OK != anystr_to_buffer(dst_varname_py, &dst_varname_ydb, TRUE)) {
+		FREE_BUFFER_ARRAY(src_subsarray_ydb, src_subs_used);
+		YDB_FREE_BUFFER(&src_varname_ydb);
+		return NULL;
+	}
+	if (YDB_OK != populate_subs_used_and_subsarray(dst_subsarray_py, &dst_subs_used, &dst_subsarray_ydb)) {
+		FREE_BUFFER_ARRAY(src_subsarray_ydb, src_subs_used);
+		YDB_FREE_BUFFER(&src_varname_ydb);
+		YDB_FREE_BUFFER(&dst_varname_ydb);
+		return NULL;
+	}
+	/* Merging a node with itself changes nothing, but merging a node with its ancestor or descendant would modify
+	 * the subtree being copied, so it is disallowed as with M MERGE.
+	 */
+	common_used = (src_subs_used < dst_subs_used) ? src_subs_used : dst_subs_used;
+	if ((0 == compare_bytes(src_varname_ydb.buf_addr, src_varname_ydb.len_used, dst_varname_ydb.buf_addr,
+				dst_varname_ydb.len_used))
+	    && (0 == collate_subsarrays(src_subsarray_ydb, common_used, dst_subsarray_ydb, common_used))) {
+		if (src_subs_used != dst_subs_used)
+			raise_ValidationError(YDBPython_ValueError, NULL, YDBPY_ERR_MERGE_DESCENDANT);
+		FREE_BUFFER_ARRAY(src_subsarray_ydb, src_subs_used);
+		FREE_BUFFER_ARRAY(dst_subsarray_ydb, dst_subs_used);
+		YDB_FREE_BUFFER(&src_varname_ydb);
+		YDB_FREE_BUFFER(&dst_varname_ydb);
+		return (src_subs_used != dst_subs_used) ? NULL : Py_BuildValue("(iO)", 0, Py_None);
+	}
+	cursor_ydb = NULL;
+	node_used = src_subs_used;
+	if ((Py_None != cursor_py) && (YDB_OK != populate_subs_used_and_subsarray(cursor_py, &node_used, &cursor_ydb))) {
+		FREE_BUFFER_ARRAY(src_subsarray_ydb, src_subs_used);
+		FREE_BUFFER_ARRAY(dst_subsarray_ydb, dst_subs_used);
+		YDB_FREE_BUFFER(&src_varname_ydb);
+		YDB_FREE_BUFFER(&dst_varname_ydb);
+		return NULL;
+	}
+	/* Use two arrays with room for the maximum number of subscripts, for the current node and the node returned by
+	 * ydb_node_next_s(), and swap them after each call to avoid copying subscripts.
+	 */
+	node = create_empty_buffer_array(YDB_MAX_SUBS, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+	next = create_empty_buffer_array(YDB_MAX_SUBS, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+	for (i = 0; i < node_used; i++)
+		copy_buffer(&node[i], (NULL == cursor_ydb) ? &src_subsarray_ydb[i] : &cursor_ydb[i]);
+	FREE_BUFFER_ARRAY(cursor_ydb, node_used);
+	/* The destination subscripts are followed by the source subscripts below the source node. The buffers are shared with
+	 * the destination and source subscript arrays rather than copied, so only the array itself is freed.
+	 */
+	target = malloc(YDB_MAX_SUBS * sizeof(ydb_buffer_t));
+	if (NULL == target) {
+		FREE_BUFFER_ARRAY(node, YDB_MAX_SUBS);
+		FREE_BUFFER_ARRAY(next, YDB_MAX_SUBS);
+		FREE_BUFFER_ARRAY(src_subsarray_ydb, src_subs_used);
+		FREE_BUFFER_ARRAY(dst_subsarray_ydb, dst_subs_used);
+		YDB_FREE_BUFFER(&src_varname_ydb);
+		YDB_FREE_BUFFER(&dst_varname_ydb);
+		return PyErr_NoMemory();
+	}
+	for (i = 0; i < dst_subs_used; i++)
+		target[i] = dst_subsarray_ydb[i];
+	YDB_MALLOC_BUFFER(&ret_value, YDBPY_DEFAULT_VALUE_LEN);
+
+	/* Call the wrapped functions until the traversal leaves the source subtree */
+	copied = found = 0;
+	status = YDB_OK;
+	/* The source node itself is only copied if the merge starts there */
+	candidate = (Py_None == cursor_py);
+	done = FALSE;
+	while (!done && (YDB_OK == status)) {
+		if (!candidate) {
+			next_used = YDB_MAX_SUBS;
+			status = ydb_node_next_s(&src_varname_ydb, node_used, node, &next_used, next);
+			/* If a buffer is not long enough */
+			while (YDB_ERR_INVSTRLEN == status) {
+				FIX_BUFFER_LENGTH(next[next_used]);
+				next_used = YDB_MAX_SUBS;
+				status = ydb_node_next_s(&src_varname_ydb, node_used, node, &next_used, next);
+			}
+			if (YDB_OK != status)
+				break;
+			swap = node;
+			node = next;
+			next = swap;
+			node_used = next_used;
+		}
+		candidate = FALSE;
+		if ((node_used < src_subs_used) || (0 != collate_subsarrays(node, src_subs_used, src_subsarray_ydb, src_subs_used)))
+			break;
+		status = ydb_get_s(&src_varname_ydb, node_used, node, &ret_value);
+		/* Check to see if length of string was longer than the value buffer. If so, try again
+		 * with proper length */
+		if (YDB_ERR_INVSTRLEN == status) {
+			FIX_BUFFER_LENGTH(ret_value);
+			status = ydb_get_s(&src_varname_ydb, node_used, node, &ret_value);
+			assert(YDB_ERR_INVSTRLEN != status);
+		}
+		if ((YDB_ERR_GVUNDEF == status) || (YDB_ERR_LVUNDEF == status)) {
+			/* The source node has no value, or the node was deleted, e.g. by another process */
+			status = YDB_OK;
+			continue;
+		} else if (YDB_OK != status)
+			break;
+		if (YDB_MAX_SUBS < dst_subs_used + node_used - src_subs_used) {
+			status = YDB_ERR_MAXNRSUBSCRIPTS;
+			break;
+		}
+		for (i = src_subs_used; i < node_used; i++)
+			target[dst_subs_used + i - src_subs_used] = node[i];
+		data_value = YDB_DATA_UNDEF;
+		if (!overwrite)
+			status = ydb_data_s(&dst_varname_ydb, dst_subs_used + node_used - src_subs_used, target, &data_value);
+		if ((YDB_OK == status) && (YDB_DATA_VALUE_NODESC != data_value) && (YDB_DATA_VALUE_DESC != data_value)) {
+			status = ydb_set_s(&dst_varname_ydb, dst_subs_used + node_used - src_subs_used, target, &ret_value);
+			copied++;
+		}
+		found++;
+		done = (found == count);
+	}
+	if ((YDB_OK == status) && done)
+		resume_py = convert_ydb_buffer_array_to_py_tuple(node, node_used); // New Reference
+	else {
+		Py_INCREF(Py_None);
+		resume_py = Py_None;
+	}
+	FREE_BUFFER_ARRAY(src_subsarray_ydb, src_subs_used);
+	FREE_BUFFER_ARRAY(dst_subsarray_ydb, dst_subs_used);
+	FREE_BUFFER_ARRAY(node, YDB_MAX_SUBS);
+	FREE_BUFFER_ARRAY(next, YDB_MAX_SUBS);
+	free(target);
+	YDB_FREE_BUFFER(&src_varname_ydb);
+	YDB_FREE_BUFFER(&dst_varname_ydb);
+	YDB_FREE_BUFFER(&ret_value);
+
+	if ((YDB_OK != status) && (YDB_ERR_NODEEND != status)) {
+		Py_DECREF(resume_py);
+		raise_YDBError(status);
+		return NULL;
+	}
+	/* Steal the reference to resume_py */
+	ret = Py_BuildValue("(iN)", copied, resume_py);
+	return ret;
+}
+
+/* Compare the current nodes of two inputs of a merged_nodes() call by their subscripts relative to the input nodes, in
+ * collation order, and then by their input indices so that nodes with the same subscripts are returned in input order.
+ */
+static int merge_source_order(YDBMergeSource *sources, int a, int b) {
+	int result;
+
+	result = collate_subsarrays(&sources[a].node[sources[a].subs_used], sources[a].node_used - sources[a].subs_used,
+				    &sources[b].node[sources[b].subs_used], sources[b].node_used - sources[b].subs_used);
+	return (0 != result) ? result : (a - b);
+}
+
+/* Restore the order of a binary min-heap of merged_nodes() input indices after the input at position `pos` moved forward */
+static void merge_heap_sift_down(YDBMergeSource *sources, int *heap, int heap_used, int pos) {
+	int child, swap;
+
+	for (child = 2 * pos + 1; child < heap_used; child = 2 * pos + 1) {
+		if ((child + 1 < heap_used) && (0 > merge_source_order(sources, heap[child + 1], heap[child])))
+			child++;
+		if (0 <= merge_source_order(sources, heap[child], heap[pos]))
+			break;
+		swap = heap[pos];
+		heap[pos] = heap[child];
+		heap[child] = swap;
+		pos = child;
+	}
+}
+
+/* Free the buffers of the first `source_count` inputs of a merged_nodes() call, and the array of inputs itself */
+static void free_merge_sources(YDBMergeSource *sources, int source_count) {
+	YDBMergeSource *source;
+
+	for (source = sources; source < sources + source_count; source++) {
+		YDB_FREE_BUFFER(&source->varname);
+		FREE_BUFFER_ARRAY(source->subsarray, source->subs_used);
+		FREE_BUFFER_ARRAY(source->node, YDB_MAX_SUBS);
+		FREE_BUFFER_ARRAY(source->next, YDB_MAX_SUBS);
+		YDB_FREE_BUFFER(&source->value);
+	}
+	free(sources);
+}
+
+/* Traverse the subtrees of several nodes at once, returning the nodes with a value in all of them in a single collation
+ * order, as a k-way merge. Each input keeps its own ydb_node_next_s() traversal, and the inputs are kept in a binary heap
+ * ordered by the subscripts of their current nodes relative to their input nodes, so only one node per input is held in
+ * memory. `sources` is a sequence of (varname, subsarray) pairs. Returns a list of (source_index, subscripts, value)
+ * tuples for at most `count` nodes (or all of them if `count` is 0), where the subscripts are relative to the input node.
+ * Nodes with the same relative subscripts in several inputs are returned in input order.
+ *
+ * The traversal starts after the node given by `cursor`, a (source_index, subscripts) tuple as returned for the last
+ * node of a previous call, or at the input nodes themselves if `cursor` is None. All inputs are assumed to use
+ * M standard collation.
+ */
+static PyObject *merged_nodes(PyObject *self, PyObject *args, PyObject *kwds) {
+	int		count, found, source_count, heap_used, cursor_index, cursor_used, depth, status, i, j;
+	int *		heap;
+	bool		candidate;
+	PyObject *	sources_py, *cursor_py, *cursor_subsarray_py, *source_py;
+	PyObject *	varname_py, *subsarray_py, *node_py, *item, *ret;
+	ydb_buffer_t *	cursor_ydb;
+	YDBMergeSource *sources, *source;
+
+	UNUSED(self);
+	/* Default values for optional arguments passed from Python */
+	cursor_py = Py_None;
+	count = 0;
+
+	/* Parse and validate */
+	static char *kwlist[] = {"sources", "cursor", "count", NULL};
+	/* Parsed values are borrowed references, do not Py_DECREF them. */
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|Oi", kwlist, &sources_py, &cursor_py, &count))
+		return NULL;
+	if (!PySequence_Check(sources_py)) {
+		PyErr_SetString(PyExc_TypeError, "'sources' must be a sequence of (varname, subsarray) pairs");
+		return NULL;
+	}
+	if (0 > count) {
+		PyErr_SetString(PyExc_ValueError, "'count' must be a non-negative int");
+		return NULL;
+	}
+	cursor_index = -1;
+	cursor_used = 0;
+	cursor_ydb = NULL;
+	if (Py_None != cursor_py) {
+		if (!PyArg_ParseTuple(cursor_py, "iO", &cursor_index, &cursor_subsarray_py))
+			return NULL;
+		RETURN_IF_INVALID_SEQUENCE(cursor_subsarray_py, YDBPython_SubsarraySequence);
+		if (YDB_OK != populate_subs_used_and_subsarray(cursor_subsarray_py, &cursor_used, &cursor_ydb))
+			return NULL;
+	}
+
+	/* Setup for call */
+	source_count = PySequence_Length(sources_py);
+	if (0 > source_count) {
+		/* The sequence has no length, e.g. it only defines __getitem__(), and an exception has been raised */
+		FREE_BUFFER_ARRAY(cursor_ydb, cursor_used);
+		return NULL;
+	}
+	sources = calloc((0 < source_count) ? source_count : 1, sizeof(YDBMergeSource));
+	heap = malloc(((0 < source_count) ? source_count : 1) * sizeof(int));
+	if ((NULL == sources) || (NULL == heap)) {
+		FREE_BUFFER_ARRAY(cursor_ydb, cursor_used);
+		free(sources);
+		free(heap);
+		return PyErr_NoMemory();
+	}
+	for (i = 0; i < source_count; i++) {
+		source_py = PySequence_GetItem(sources_py, i); // New Reference
+		if ((NULL == source_py) || !PyArg_ParseTuple(source_py, "OO", &varname_py, &subsarray_py)) {
+			Py_XDECREF(source_py);
+			PyErr_Clear();
+			raise_ValidationError(YDBPython_TypeError, NULL, YDBPY_ERR_MERGE_SOURCE);
+			break;
+		}
+		source = &sources[i];
+		if ((!is_valid_sequence(subsarray_py, YDBPython_SubsarraySequence, NULL))
+		    || (YDB_OK != anystr_to_buffer(varname_py, &source->varname, TRUE))) {
+			Py_DECREF(source_py);
+			break;
+		}
+		if (YDB_OK != populate_subs_used_and_subsarray(subsarray_py, &source->subs_used, &source->subsarray)) {
+			Py_DECREF(source_py);
+			YDB_FREE_BUFFER(&source->varname);
+			break;
+		}
+		Py_DECREF(source_py);
+		source->node = create_empty_buffer_array(YDB_MAX_SUBS, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+		source->next = create_empty_buffer_array(YDB_MAX_SUBS, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+		YDB_MALLOC_BUFFER(&source->value, YDBPY_DEFAULT_VALUE_LEN);
+	}
+	if (i < source_count) {
+		FREE_BUFFER_ARRAY(cursor_ydb, cursor_used);
+		free_merge_sources(sources, i);
+		free(heap);
+		return NULL;
+	}
+	/* Position each input at its first node with a value, starting at the input node followed by the cursor, if any.
+	 * Inputs up to and including the input of the cursor have already returned a node with the cursor subscripts,
+	 * if they had one, so their traversals start after it.
+	 */
+	status = YDB_OK;
+	heap_used = 0;
+	for (i = 0; (YDB_OK == status) && (i < source_count); i++) {
+		source = &sources[i];
+		if (YDB_MAX_SUBS < source->subs_used + cursor_used) {
+			status = YDB_ERR_MAXNRSUBSCRIPTS;
+			break;
+		}
+		for (j = 0; j < source->subs_used; j++)
+			copy_buffer(&source->node[j], &source->subsarray[j]);
+		for (j = 0; j < cursor_used; j++)
+			copy_buffer(&source->node[source->subs_used + j], &cursor_ydb[j]);
+		source->node_used = source->subs_used + cursor_used;
+		candidate = (Py_None == cursor_py) || (cursor_index < i);
+		status = next_node_in_subtree(&source->varname, source->subs_used, source->subsarray, &source->node, &source->next,
+					      &source->node_used, &source->value, candidate, &source->in_subtree);
+		if (source->in_subtree)
+			heap[heap_used++] = i;
+	}
+	FREE_BUFFER_ARRAY(cursor_ydb, cursor_used);
+	for (i = heap_used / 2 - 1; 0 <= i; i--)
+		merge_heap_sift_down(sources, heap, heap_used, i);
+
+	/* Return the node of the input at the top of the heap and move that input forward until all inputs are complete */
+	ret = PyList_New(0); // New Reference
+	found = 0;
+	while ((NULL != ret) && (YDB_OK == status) && (0 < heap_used) && ((0 == count) || (found < count))) {
+		source = &sources[heap[0]];
+		depth = source->node_used - source->subs_used;
+		node_py = convert_ydb_buffer_array_to_py_tuple(&source->node[source->subs_used], depth); // New Reference
+		if (NULL == node_py) {
+			Py_CLEAR(ret);
+			break;
+		}
+		/* Steal the reference to node_py */
+		item = Py_BuildValue("(iNy#)", heap[0], node_py, source->value.buf_addr, (Py_ssize_t)source->value.len_used);
+		if ((NULL == item) || (0 != PyList_Append(ret, item))) {
+			Py_XDECREF(item);
+			Py_CLEAR(ret);
+			break;
+		}
+		Py_DECREF(item);
+		found++;
+		status = next_node_in_subtree(&source->varname, source->subs_used, source->subsarray, &source->node, &source->next,
+					      &source->node_used, &source->value, FALSE, &source->in_subtree);
+		if (!source->in_subtree)
+			heap[0] = heap[--heap_used];
+		merge_heap_sift_down(sources, heap, heap_used, 0);
+	}
+	free_merge_sources(sources, source_count);
+	free(heap);
+
+	if (YDB_OK != status) {
+		Py_XDECREF(ret);
+		raise_YDBError(status);
+		return NULL;
+	}
+	return ret;
+}
+
+/* Reset the running totals of an aggregate() call */
+static void init_aggregate(YDBAggregate *aggregate) {
+	aggregate->count = 0;
+	aggregate->is_integer = TRUE;
+	aggregate->integer_sum = aggregate->integer_min = aggregate->integer_max = 0;
+	aggregate->sum = aggregate->min = aggregate->max = 0;
+}
+
+/* Add the value in `value` to the running totals of an aggregate() call if it is a canonical number */
+static void add_to_aggregate(YDBAggregate *aggregate, ydb_buffer_t *value) {
+	char	    number[CANONICAL_NUMBER_TO_STRING_MAX + 1];
+	long double val;
+	long long   integer;
+	bool	    is_integer;
+
+	if ((CANONICAL_NUMBER_TO_STRING_MAX < value->len_used) || !is_canonical_number(value->buf_addr, value->len_used))
+		return;
+	memcpy(number, value->buf_addr, value->len_used);
+	number[value->len_used] = '\0';
+	/* Canonical integers have no decimal point, and fit in a long long if they have at most 18 digits */
+	is_integer = (NULL == memchr(number, '.', value->len_used))
+		     && (CANONICAL_NUMBER_MAX_DIGITS >= value->len_used - (('-' == number[0]) ? 1 : 0));
+	val = strtold(number, NULL);
+	if (is_integer) {
+		integer = strtoll(number, NULL, 10);
+		if ((0 == aggregate->count) || (integer < aggregate->integer_min))
+			aggregate->integer_min = integer;
+		if ((0 == aggregate->count) || (integer > aggregate->integer_max))
+			aggregate->integer_max = integer;
+		if (((0 < integer) && (LLONG_MAX - integer < aggregate->integer_sum))
+		    || ((0 > integer) && (LLONG_MIN - integer > aggregate->integer_sum)))
+			aggregate->is_integer = FALSE;
+		else
+			aggregate->integer_sum += integer;
+	} else
+		aggregate->is_integer = FALSE;
+	if ((0 == aggregate->count) || (val < aggregate->min))
+		aggregate->min = val;
+	if ((0 == aggregate->count) || (val > aggregate->max))
+		aggregate->max = val;
+	aggregate->sum += val;
+	aggregate->count++;
+}
+
+/* Add the running totals in `src` to those in `dest` */
+static void merge_aggregates(YDBAggregate *dest, YDBAggregate *src) {
+	if (0 == src->count)
+		return;
+	if (0 == dest->count) {
+		*dest = *src;
+		return;
+	}
+	if (dest->is_integer && src->is_integer) {
+		if (((0 < src->integer_sum) && (LLONG_MAX - src->integer_sum < dest->integer_sum))
+		    || ((0 > src->integer_sum) && (LLONG_MIN - src->integer_sum > dest->integer_sum)))
+			dest->is_integer = FALSE;
+		else
+			dest->integer_sum += src->integer_sum;
+		if (src->integer_min < dest->integer_min)
+			dest->integer_min = src->integer_min;
+		if (src->integer_max > dest->integer_max)
+			dest->integer_max = src->integer_max;
+	} else
+		dest->is_integer = FALSE;
+	if (src->min < dest->min)
+		dest->min = src->min;
+	if (src->max > dest->max)
+		dest->max = src->max;
+	dest->sum += src->sum;
+	dest->count += src->count;
+}
+
+/* Merge the running totals of a group of an aggregate() call into the totals stored for its subscript in the `groups`
+ * dictionary. The totals are stored as bytearrays holding a YDBAggregate until they are converted by
+ * groups_to_py_dict(), as a group may be split across the subtrees of several nodes above the group level.
+ * Returns 0 on success, or -1 with a Python exception set.
+ */
+static int store_group_aggregate(PyObject *groups, ydb_buffer_t *group, YDBAggregate *totals) {
+	PyObject *group_py, *stored_py;
+	int	  ret;
+
+	group_py = PyBytes_FromStringAndSize(group->buf_addr, group->len_used); // New Reference
+	if (NULL == group_py)
+		return -1;
+	stored_py = PyDict_GetItemWithError(groups, group_py); // Borrowed Reference
+	if (NULL != stored_py) {
+		merge_aggregates((YDBAggregate *)PyByteArray_AS_STRING(stored_py), totals);
+		ret = 0;
+	} else if (PyErr_Occurred()) {
+		ret = -1;
+	} else {
+		stored_py = PyByteArray_FromStringAndSize((const char *)totals, sizeof(YDBAggregate)); // New Reference
+		if (NULL == stored_py) {
+			ret = -1;
+		} else {
+			ret = PyDict_SetItem(groups, group_py, stored_py);
+			Py_DECREF(stored_py);
+		}
+	}
+	Py_DECREF(group_py);
+	return ret;
+}
+
+/* Convert the running totals of an aggregate() call to a (count, sum, min, max) tuple. The sum, min, and max are
+ * integers if all values were integers whose sum fits in a long long, and floats otherwise. The min and max are
+ * None if there were no values.
+ */
+static PyObject *aggregate_to_py_tuple(YDBAggregate *aggregate) {
+	if (0 == aggregate->count)
+		return Py_BuildValue("(KiOO)", aggregate->count, 0, Py_None, Py_None);
+	if (aggregate->is_integer)
+		return Py_BuildValue("(KLLL)", aggregate->count, aggregate->integer_sum, aggregate->integer_min,
+				     aggregate->integer_max);
+	return Py_BuildValue("(Kddd)", aggregate->count, (double)aggregate->sum, (double)aggregate->min, (double)aggregate->max);
+}
+
+/* Replace the totals stored by store_group_aggregate() in the `groups` dictionary with (count, sum, min, max) tuples.
+ * Returns 0 on success, or -1 with a Python exception set.
+ */
+static int groups_to_py_dict(PyObject *groups) {
+	PyObject * group_py, *stored_py, *totals_py;
+	Py_ssize_t pos;
+
+	pos = 0;
+	/* Replacing the values of existing keys does not change the size of the dictionary, so is safe while iterating */
+	while (PyDict_Next(groups, &pos, &group_py, &stored_py)) {
+		totals_py = aggregate_to_py_tuple((YDBAggregate *)PyByteArray_AS_STRING(stored_py)); // New Reference
+		if ((NULL == totals_py) || (0 != PyDict_SetItem(groups, group_py, totals_py))) {
+			Py_XDECREF(totals_py);
+			return -1;
+		}
+		Py_DECREF(totals_py);
+	}
+	return 0;
+}
+
+/* Compute the count, sum, minimum, and maximum of the values of the nodes in the subtree of a node that are canonical
+ * numbers, by traversing the subtree with ydb_node_next_s() and converting the values in C. Values that are not canonical
+ * numbers are ignored. Returns a (count, sum, min, max) tuple.
+ *
+ * If `depth` is not negative, only the nodes `depth` levels below the given node are included, and the subtrees below
+ * them are skipped rather than traversed. If `group_level` is greater than 0, a dictionary is returned instead, mapping
+ * each subscript at that many levels below the given node to a tuple for the nodes in its subtree.
+ */
+static PyObject *aggregate(PyObject *self, PyObject *args, PyObject *kwds) {
+	int	      depth, group_level, node_used, next_used, status, subs_used, i;
+	unsigned int  data_value;
+	bool	      candidate, in_group, py_error;
+	PyObject *    varname_py, *subsarray_py, *ret;
+	ydb_buffer_t  varname_ydb, value, group;
+	ydb_buffer_t *subsarray_ydb, *node, *next, *swap;
+	YDBAggregate  totals;
+
+	UNUSED(self);
+	subs_used = 0;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	subsarray_ydb = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	/* Default values for optional arguments passed from Python */
+	subsarray_py = Py_None;
+	depth = -1;
+	group_level = 0;
+
+	/* Parse and validate */
+	static char *kwlist[] = {"varname", "subsarray", "depth", "group_level", NULL};
+	/* Parsed values are borrowed references, do not Py_DECREF them. */
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|Oii", kwlist, &varname_py, &subsarray_py, &depth, &group_level))
+		return NULL;
+	RETURN_IF_INVALID_SEQUENCE(subsarray_py, YDBPython_SubsarraySequence);
+	if (0 > group_level) {
+		PyErr_SetString(PyExc_ValueError, "'group_level' must be a non-negative int");
+		return NULL;
+	}
+
+	/* Setup for call */
+	INVOKE_ANYSTR_TO_BUFFER(varname_py, varname_ydb, TRUE);
+	INVOKE_POPULATE_SUBS_USED_AND_SUBSARRAY_AND_CLEANUP_VARNAME(subsarray_py, subs_used, subsarray_ydb, varname_ydb);
+	/* Use two arrays with room for the maximum number of subscripts, for the current node and the node returned by
+	 * ydb_node_next_s(), and swap them after each call to avoid copying subscripts.
+	 */
+	node = create_empty_buffer_array(YDB_MAX_SUBS, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+	next = create_empty_buffer_array(YDB_MAX_SUBS, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+	for (i = 0; i < subs_used; i++)
+		copy_buffer(&node[i], &subsarray_ydb[i]);
+	node_used = subs_used;
+	/* Any canonical number fits in this buffer, so a YDB_ERR_INVSTRLEN return signals a value that is not a number
+	 * without copying it.
+	 */
+	YDB_MALLOC_BUFFER(&value, CANONICAL_NUMBER_TO_STRING_MAX);
+	YDB_MALLOC_BUFFER(&group, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+	init_aggregate(&totals);
+	ret = (0 < group_level) ? PyDict_New() : NULL; // New Reference
+	in_group = FALSE;
+	py_error = (0 < group_level) && (NULL == ret);
+
+	/* Call the wrapped functions until the traversal leaves the subtree */
+	status = YDB_OK;
+	/* The given node is only included if its depth is included */
+	candidate = (0 >= depth) && (0 == group_level);
+	while ((YDB_OK == status) && !py_error) {
+		if (!candidate) {
+			next_used = YDB_MAX_SUBS;
+			status = ydb_node_next_s(&varname_ydb, node_used, node, &next_used, next);
+			/* If a buffer is not long enough */
+			while (YDB_ERR_INVSTRLEN == status) {
+				FIX_BUFFER_LENGTH(next[next_used]);
+				next_used = YDB_MAX_SUBS;
+				status = ydb_node_next_s(&varname_ydb, node_used, node, &next_used, next);
+			}
+			if (YDB_OK != status)
+				break;
+			swap = node;
+			node = next;
+			next = swap;
+			node_used = next_used;
+			if ((node_used < subs_used) || (0 != collate_subsarrays(node, subs_used, subsarray_ydb, subs_used)))
+				break;
+		}
+		candidate = FALSE;
+		if ((0 <= depth) && (depth < node_used - subs_used)) {
+			/* Skip past the subtree of the ancestor at `depth` by moving to the next subscript at that level, or at
+			 * the level above if there are no more subscripts at that level, until the given node is reached.
+			 */
+			node_used = subs_used + depth;
+			status = YDB_ERR_NODEEND;
+			while ((subs_used < node_used) && (YDB_ERR_NODEEND == status)) {
+				status = subscript_next_or_previous(&varname_ydb, node_used, node, &next[0], FALSE);
+				if (YDB_OK == status)
+					copy_buffer(&node[node_used - 1], &next[0]);
+				else if (YDB_ERR_NODEEND == status)
+					node_used--;
+			}
+			if (YDB_OK != status)
+				break;
+			/* The next subscript may not have a value itself, in which case the traversal continues with its subtree */
+			status = ydb_data_s(&varname_ydb, node_used, node, &data_value);
+			if (YDB_OK == status)
+				candidate = (YDB_DATA_VALUE_NODESC == data_value) || (YDB_DATA_VALUE_DESC == data_value);
+			continue;
+		}
+		if ((0 <= depth) && (depth != node_used - subs_used))
+			continue;
+		if (0 < group_level) {
+			/* Nodes above the group level are not in any group */
+			if (node_used - subs_used < group_level)
+				continue;
+			/* The nodes of a group are contiguous within the subtree of the node above the group level, so the totals
+			 * of a group are accumulated until its subscript changes and then merged into the dictionary.
+			 */
+			if (in_group
+			    && ((group.len_used != node[subs_used + group_level - 1].len_used)
+				|| (0 != memcmp(group.buf_addr, node[subs_used + group_level - 1].buf_addr, group.len_used)))) {
+				if (0 != store_group_aggregate(ret, &group, &totals)) {
+					py_error = TRUE;
+					break;
+				}
+				init_aggregate(&totals);
+				in_group = FALSE;
+			}
+			if (!in_group) {
+				copy_buffer(&group, &node[subs_used + group_level - 1]);
+				in_group = TRUE;
+			}
+		}
+		status = ydb_get_s(&varname_ydb, node_used, node, &value);
+		if (YDB_OK == status)
+			add_to_aggregate(&totals, &value);
+		else if ((YDB_ERR_INVSTRLEN == status) || (YDB_ERR_GVUNDEF == status) || (YDB_ERR_LVUNDEF == status)) {
+			/* The value is too long to be a number, the given node has no value, or the node was deleted,
+			 * e.g. by another process.
+			 */
+			status = YDB_OK;
+		}
+	}
+	FREE_BUFFER_ARRAY(subsarray_ydb, subs_used);
+	FREE_BUFFER_ARRAY(node, YDB_MAX_SUBS);
+	FREE_BUFFER_ARRAY(next, YDB_MAX_SUBS);
+	YDB_FREE_BUFFER(&varname_ydb);
+	YDB_FREE_BUFFER(&value);
+
+	if (!py_error && (YDB_OK != status) && (YDB_ERR_NODEEND != status)) {
+		raise_YDBError(status);
+		py_error = TRUE;
+	}
+	if (!py_error && (0 < group_level))
+		py_error = (in_group && (0 != store_group_aggregate(ret, &group, &totals))) || (0 != groups_to_py_dict(ret));
+	YDB_FREE_BUFFER(&group);
+	if (py_error) {
+		Py_XDECREF(ret);
+		return NULL;
+	}
+	if (0 == group_level)
+		ret = aggregate_to_py_tuple(&totals); // New Reference
+	return ret;
+}
+
+/* Wrapper for ydb_node_next_s() */
+static PyObject *node_next(PyObject *self, PyObject *args, PyObject *kwds) {
+	int	      max_subscript_string, ret_subsarray_num_elements, ret_subs_used, status, subs_used;
+	PyObject *    varname_py;
+	PyObject *    subsarray_py, *default_py, *ret;
+	const char *  encoding, *errors;
+	ydb_buffer_t  varname_ydb;
+	ydb_buffer_t *ret_subsarray, *subsarray_ydb;
+
+	UNUSED(self);
+	ret = NULL;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	subs_used = 0;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	subsarray_ydb = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	/* Default values for optional arguments passed from Python */
+	subsarray_py = Py_None;
+	default_py = NULL;
+	encoding = NULL;
+	errors = "strict";
+
+	/* Parse and validate */
+	static char *kwlist[] = {"varname", "subsarray", "default", "decode", "errors", NULL};
+	/* Parsed values are borrowed references, do not Py_DECREF them. */
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOzs", kwlist, &varname_py, &subsarray_py, &default_py, &encoding,
+					 &errors))
+		return NULL;
+	RETURN_IF_INVALID_SEQUENCE(subsarray_py, YDBPython_SubsarraySequence);
+
 	/* Setup for Call */
 	INVOKE_ANYSTR_TO_BUFFER(varname_py, varname_ydb, TRUE);
 	INVOKE_POPULATE_SUBS_USED_AND_SUBSARRAY_AND_CLEANUP_VARNAME(subsarray_py, subs_used, subsarray_ydb, varname_ydb);
@@ -1808,12 +3538,16 @@ static PyObject *node_next(PyObject *self, PyObject *args, PyObject *kwds) {
 	assert(YDB_ERR_INVSTRLEN != status);
 
 	/* Check status for errors and Raise Exception */
-	if (YDB_OK != status) {
+	if ((YDB_ERR_NODEEND == status) && (NULL != default_py)) {
+		/* Signal the end of the traversal to the caller without the overhead of raising YDBNodeEnd */
+		Py_INCREF(default_py);
+		ret = default_py;
+	} else if (YDB_OK != status) {
 		raise_YDBError(status);
 	} else {
 		/* Create Python object to return */
 		/* New Reference */
-		ret = convert_ydb_buffer_array_to_py_tuple(ret_subsarray, ret_subs_used);
+		ret = decode_ydb_buffer_array_to_py_tuple(ret_subsarray, ret_subs_used, encoding, errors);
 	}
 	FREE_BUFFER_ARRAY(ret_subsarray, ret_subsarray_num_elements);
 	return ret;
@@ -1823,7 +3557,8 @@ static PyObject *node_next(PyObject *self, PyObject *args, PyObject *kwds) {
 static PyObject *node_previous(PyObject *self, PyObject *args, PyObject *kwds) {
 	int	      max_subscript_string, ret_subsarray_num_elements, ret_subs_used, status, subs_used;
 	PyObject *    varname_py;
-	PyObject *    subsarray_py, *ret;
+	PyObject *    subsarray_py, *default_py, *ret;
+	const char *  encoding, *errors;
 	ydb_buffer_t  varname_ydb;
 	ydb_buffer_t *ret_subsarray, *subsarray_ydb;
 
@@ -1833,11 +3568,15 @@ static PyObject *node_previous(PyObject *self, PyObject *args, PyObject *kwds) {
 	subsarray_ydb = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
 	/* Default values for optional arguments passed from Python */
 	subsarray_py = Py_None;
+	default_py = NULL;
+	encoding = NULL;
+	errors = "strict";
 
 	/* Parse and validate */
-	static char *kwlist[] = {"varname", "subsarray", NULL};
+	static char *kwlist[] = {"varname", "subsarray", "default", "decode", "errors", NULL};
 	/* Parsed values are borrowed references, do not Py_DECREF them. */
-	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &varname_py, &subsarray_py))
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOzs", kwlist, &varname_py, &subsarray_py, &default_py, &encoding,
+					 &errors))
 		return NULL;
 	RETURN_IF_INVALID_SEQUENCE(subsarray_py, YDBPython_SubsarraySequence);
 
@@ -1871,16 +3610,207 @@ static PyObject *node_previous(PyObject *self, PyObject *args, PyObject *kwds) {
 	assert(YDB_ERR_INVSTRLEN != status);
 
 	/* Check status for errors and raise Exception */
-	if (YDB_OK != status) {
+	if ((YDB_ERR_NODEEND == status) && (NULL != default_py)) {
+		/* Signal the end of the traversal to the caller without the overhead of raising YDBNodeEnd */
+		Py_INCREF(default_py);
+		ret = default_py;
+	} else if (YDB_OK != status) {
 		raise_YDBError(status);
 	} else {
 		/* Create Python object to return. Creates a new reference */
-		ret = convert_ydb_buffer_array_to_py_tuple(ret_subsarray, ret_subs_used);
+		ret = decode_ydb_buffer_array_to_py_tuple(ret_subsarray, ret_subs_used, encoding, errors);
 	}
 	FREE_BUFFER_ARRAY(ret_subsarray, ret_subsarray_num_elements);
 	return ret;
 }
 
+/* Scan the nodes of a local or global variable that have a value, in depth-first order, starting after the node
+ * specified by `subsarray` in the direction given by `reverse`, and return a list of at most `count` subscript tuples
+ * (or all of them if `count` is 0) that collate between `start` (inclusive) and `stop` (exclusive) and are in the
+ * subtree under `prefix`. In reverse, an empty `subsarray` starts the scan at the last node of the variable.
+ *
+ * The scan seeks directly to `start` or `prefix` (or `stop` or the last node under `prefix`, in reverse) and ends
+ * as soon as a node falls outside of the boundaries, so that only the nodes within the boundaries are read.
+ */
+static PyObject *node_scan(PyObject *self, PyObject *args, PyObject *kwds) {
+	int	      count, found, node_used, next_used, reverse, status, subs_used, i;
+	unsigned int  data_value;
+	bool	      at_end, candidate, done;
+	PyObject *    varname_py, *subsarray_py, *start_py, *stop_py, *prefix_py;
+	PyObject *    node_py, *ret;
+	ydb_buffer_t  varname_ydb, ret_value;
+	ydb_buffer_t *subsarray_ydb, *node, *next, *swap;
+	YDBNodeBounds bounds;
+
+	UNUSED(self);
+	subs_used = 0;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	subsarray_ydb = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	/* Default values for optional arguments passed from Python */
+	subsarray_py = Py_None;
+	start_py = Py_None;
+	stop_py = Py_None;
+	prefix_py = Py_None;
+	count = 0;
+	reverse = FALSE;
+
+	/* Parse and validate */
+	static char *kwlist[] = {"varname", "subsarray", "start", "stop", "prefix", "count", "reverse", NULL};
+	/* Parsed values are borrowed references, do not Py_DECREF them. */
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOOOip", kwlist, &varname_py, &subsarray_py, &start_py, &stop_py,
+					 &prefix_py, &count, &reverse))
+		return NULL;
+	RETURN_IF_INVALID_SEQUENCE(subsarray_py, YDBPython_SubsarraySequence);
+	RETURN_IF_INVALID_SEQUENCE(start_py, YDBPython_SubsarraySequence);
+	RETURN_IF_INVALID_SEQUENCE(stop_py, YDBPython_SubsarraySequence);
+	RETURN_IF_INVALID_SEQUENCE(prefix_py, YDBPython_SubsarraySequence);
+	if (0 > count) {
+		PyErr_SetString(PyExc_ValueError, "'count' must be a non-negative int");
+		return NULL;
+	}
+
+	/* Setup for call */
+	INVOKE_ANYSTR_TO_BUFFER(varname_py, varname_ydb, TRUE);
+	INVOKE_POPULATE_SUBS_USED_AND_SUBSARRAY_AND_CLEANUP_VARNAME(subsarray_py, subs_used, subsarray_ydb, varname_ydb);
+	if (YDB_OK != populate_node_bounds(start_py, stop_py, prefix_py, &bounds)) {
+		free_node_bounds(&bounds);
+		FREE_BUFFER_ARRAY(subsarray_ydb, subs_used);
+		YDB_FREE_BUFFER(&varname_ydb);
+		return NULL;
+	}
+	/* Use two arrays with room for the maximum number of subscripts, for the current node and the node returned by
+	 * ydb_node_next_s() or ydb_node_previous_s(), and swap them after each call to avoid copying subscripts.
+	 */
+	node = create_empty_buffer_array(YDB_MAX_SUBS, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+	next = create_empty_buffer_array(YDB_MAX_SUBS, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+	for (i = 0; i < subs_used; i++)
+		copy_buffer(&node[i], &subsarray_ydb[i]);
+	node_used = subs_used;
+	FREE_BUFFER_ARRAY(subsarray_ydb, subs_used);
+	YDB_MALLOC_BUFFER(&ret_value, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+
+	/* Seek to the first node within the boundaries */
+	status = YDB_OK;
+	candidate = done = FALSE;
+	if (!reverse) {
+		if ((0 <= bounds.start_used) && (0 <= collate_subsarrays(bounds.start, bounds.start_used, node, node_used))) {
+			for (i = 0; i < bounds.start_used; i++)
+				copy_buffer(&node[i], &bounds.start[i]);
+			node_used = bounds.start_used;
+			candidate = TRUE;
+		}
+		if ((0 <= bounds.prefix_used) && (0 < collate_subsarrays(bounds.prefix, bounds.prefix_used, node, node_used))) {
+			for (i = 0; i < bounds.prefix_used; i++)
+				copy_buffer(&node[i], &bounds.prefix[i]);
+			node_used = bounds.prefix_used;
+			candidate = TRUE;
+		}
+	} else {
+		/* In reverse, the scan starts before the given node, or at the last node if no node is given */
+		at_end = (0 == node_used);
+		if (0 <= bounds.stop_used) {
+			/* No node precedes the root node of the variable */
+			done = (0 == bounds.stop_used);
+			if (at_end || (0 > collate_subsarrays(bounds.stop, bounds.stop_used, node, node_used))) {
+				for (i = 0; i < bounds.stop_used; i++)
+					copy_buffer(&node[i], &bounds.stop[i]);
+				node_used = bounds.stop_used;
+				at_end = FALSE;
+			}
+		}
+		if (!done && (at_end || (0 <= bounds.prefix_used))) {
+			/* Find the last node under `prefix`, or of the variable, by descending through the last
+			 * subscript at each level.
+			 */
+			next_used = (0 <= bounds.prefix_used) ? bounds.prefix_used : 0;
+			for (i = 0; i < next_used; i++)
+				copy_buffer(&next[i], &bounds.prefix[i]);
+			while (next_used < YDB_MAX_SUBS) {
+				next[next_used].len_used = 0;
+				status = subscript_next_or_previous(&varname_ydb, next_used + 1, next, &ret_value, TRUE);
+				if (YDB_OK != status)
+					break;
+				copy_buffer(&next[next_used], &ret_value);
+				next_used++;
+			}
+			if (YDB_ERR_NODEEND == status)
+				status = YDB_OK;
+			if ((YDB_OK == status) && (at_end || (0 > collate_subsarrays(next, next_used, node, node_used)))) {
+				swap = node;
+				node = next;
+				next = swap;
+				node_used = next_used;
+				candidate = TRUE;
+			}
+		}
+	}
+	if (candidate && (YDB_OK == status)) {
+		/* Only nodes with a value are included, as with ydb_node_next_s() and ydb_node_previous_s() */
+		status = ydb_data_s(&varname_ydb, node_used, node, &data_value);
+		candidate = (YDB_DATA_VALUE_NODESC == data_value) || (YDB_DATA_VALUE_DESC == data_value);
+	}
+
+	/* Call the wrapped function until a node falls outside of the boundaries */
+	ret = PyList_New(0); // New Reference
+	done = done || (NULL == ret);
+	found = 0;
+	while (!done && (YDB_OK == status)) {
+		if (!candidate) {
+			next_used = YDB_MAX_SUBS;
+			if (reverse)
+				status = ydb_node_previous_s(&varname_ydb, node_used, node, &next_used, next);
+			else
+				status = ydb_node_next_s(&varname_ydb, node_used, node, &next_used, next);
+			/* If a buffer is not long enough */
+			while (YDB_ERR_INVSTRLEN == status) {
+				FIX_BUFFER_LENGTH(next[next_used]);
+				next_used = YDB_MAX_SUBS;
+				if (reverse)
+					status = ydb_node_previous_s(&varname_ydb, node_used, node, &next_used, next);
+				else
+					status = ydb_node_next_s(&varname_ydb, node_used, node, &next_used, next);
+			}
+			if (YDB_OK != status)
+				break;
+			swap = node;
+			node = next;
+			next = swap;
+			node_used = next_used;
+		}
+		candidate = FALSE;
+		switch (check_node_bounds(node, node_used, &bounds, reverse)) {
+		case YDBPython_ScanEnd:
+			done = TRUE;
+			break;
+		case YDBPython_ScanMatch:
+			node_py = convert_ydb_buffer_array_to_py_tuple(node, node_used); // New Reference
+			if ((NULL == node_py) || (0 != PyList_Append(ret, node_py))) {
+				Py_XDECREF(node_py);
+				Py_CLEAR(ret);
+				done = TRUE;
+				break;
+			}
+			Py_DECREF(node_py);
+			found++;
+			done = (found == count);
+			break;
+		case YDBPython_ScanSkip:
+			break;
+		}
+	}
+	FREE_BUFFER_ARRAY(node, YDB_MAX_SUBS);
+	FREE_BUFFER_ARRAY(next, YDB_MAX_SUBS);
+	YDB_FREE_BUFFER(&ret_value);
+	YDB_FREE_BUFFER(&varname_ydb);
+	free_node_bounds(&bounds);
+
+	if ((YDB_OK != status) && (YDB_ERR_NODEEND != status)) {
+		Py_XDECREF(ret);
+		raise_YDBError(status);
+		return NULL;
+	}
+	return ret;
+}
+
 /* Wrapper for ydb_set_s() */
 static PyObject *set(PyObject *self, PyObject *args, PyObject *kwds) {
 	int	      status = YDB_OK, subs_used;
@@ -1983,7 +3913,8 @@ static PyObject *str2zwr(PyObject *self, PyObject *args, PyObject *kwds) {
 static PyObject *subscript_next(PyObject *self, PyObject *args, PyObject *kwds) {
 	int	      status, subs_used;
 	PyObject *    varname_py;
-	PyObject *    subsarray_py, *ret;
+	PyObject *    subsarray_py, *default_py, *ret;
+	const char *  encoding, *errors;
 	ydb_buffer_t  ret_value, varname_ydb;
 	ydb_buffer_t *subsarray_ydb;
 
@@ -1993,11 +3924,15 @@ static PyObject *subscript_next(PyObject *self, PyObject *args, PyObject *kwds)
 	subsarray_ydb = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
 	/* Default values for optional arguments passed from Python */
 	subsarray_py = Py_None;
+	default_py = NULL;
+	encoding = NULL;
+	errors = "strict";
 
 	/* Parse and validate */
-	static char *kwlist[] = {"varname", "subsarray", NULL};
+	static char *kwlist[] = {"varname", "subsarray", "default", "decode", "errors", NULL};
 	/* Parsed values are borrowed references, do not Py_DECREF them. */
-	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &varname_py, &subsarray_py)) {
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOzs", kwlist, &varname_py, &subsarray_py, &default_py,
+					 &encoding, &errors)) {
 		return NULL;
 	}
 	RETURN_IF_INVALID_SEQUENCE(subsarray_py, YDBPython_SubsarraySequence);
@@ -2020,11 +3955,15 @@ static PyObject *subscript_next(PyObject *self, PyObject *args, PyObject *kwds)
 	FREE_BUFFER_ARRAY(subsarray_ydb, subs_used);
 	YDB_FREE_BUFFER(&varname_ydb);
 
-	if (YDB_OK != status) {
+	if ((YDB_ERR_NODEEND == status) && (NULL != default_py)) {
+		/* Signal the end of the traversal to the caller without the overhead of raising YDBNodeEnd */
+		Py_INCREF(default_py);
+		ret = default_py;
+	} else if (YDB_OK != status) {
 		raise_YDBError(status);
 	} else {
 		/* Create Python object to return. Creates new reference */
-		ret = Py_BuildValue("y#", ret_value.buf_addr, (Py_ssize_t)ret_value.len_used);
+		ret = new_object_from_buffer(&ret_value, encoding, errors);
 	}
 	YDB_FREE_BUFFER(&ret_value);
 	return ret;
@@ -2034,7 +3973,8 @@ static PyObject *subscript_next(PyObject *self, PyObject *args, PyObject *kwds)
 static PyObject *subscript_previous(PyObject *self, PyObject *args, PyObject *kwds) {
 	int	      status, subs_used;
 	PyObject *    varname_py;
-	PyObject *    subsarray_py, *ret;
+	PyObject *    subsarray_py, *default_py, *ret;
+	const char *  encoding, *errors;
 	ydb_buffer_t  ret_value, varname_ydb;
 	ydb_buffer_t *subsarray_ydb;
 
@@ -2044,11 +3984,15 @@ static PyObject *subscript_previous(PyObject *self, PyObject *args, PyObject *kw
 	subsarray_ydb = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
 	/* Default values for optional arguments passed from Python */
 	subsarray_py = Py_None;
+	default_py = NULL;
+	encoding = NULL;
+	errors = "strict";
 
 	/* Parse and validate */
-	static char *kwlist[] = {"varname", "subsarray", NULL};
+	static char *kwlist[] = {"varname", "subsarray", "default", "decode", "errors", NULL};
 	/* Parsed values are borrowed references, do not Py_DECREF them. */
-	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &varname_py, &subsarray_py)) {
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOzs", kwlist, &varname_py, &subsarray_py, &default_py,
+					 &encoding, &errors)) {
 		return NULL;
 	}
 	RETURN_IF_INVALID_SEQUENCE(subsarray_py, YDBPython_SubsarraySequence);
@@ -2069,18 +4013,752 @@ static PyObject *subscript_previous(PyObject *self, PyObject *args, PyObject *kw
 		status = ydb_subscript_previous_s(&varname_ydb, subs_used, subsarray_ydb, &ret_value);
 		assert(YDB_ERR_INVSTRLEN != status);
 	}
-	YDB_FREE_BUFFER(&varname_ydb);
-	FREE_BUFFER_ARRAY(subsarray_ydb, subs_used);
+	YDB_FREE_BUFFER(&varname_ydb);
+	FREE_BUFFER_ARRAY(subsarray_ydb, subs_used);
+
+	/* Check status for Errors and Raise Exception */
+	if ((YDB_ERR_NODEEND == status) && (NULL != default_py)) {
+		/* Signal the end of the traversal to the caller without the overhead of raising YDBNodeEnd */
+		Py_INCREF(default_py);
+		ret = default_py;
+	} else if (YDB_OK != status) {
+		raise_YDBError(status);
+	} else {
+		/* Create Python object to return. Creates a new reference */
+		ret = new_object_from_buffer(&ret_value, encoding, errors);
+	}
+	YDB_FREE_BUFFER(&ret_value);
+	return ret;
+}
+
+/* Count the child subscripts of a node by iterating over them with ydb_subscript_next_s(), without
+ * creating a Python object for each subscript.
+ */
+static PyObject *subscript_count(PyObject *self, PyObject *args, PyObject *kwds) {
+	int		   status, subs_used;
+	unsigned long long count;
+	PyObject *	   varname_py;
+	PyObject *	   subsarray_py;
+	ydb_buffer_t	   varname_ydb, ret_value, swap;
+	ydb_buffer_t *	   subsarray_ydb, *new_subsarray_ydb;
+
+	UNUSED(self);
+	subs_used = 0;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	subsarray_ydb = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	/* Default values for optional arguments passed from Python */
+	subsarray_py = Py_None;
+
+	/* Parse and validate */
+	static char *kwlist[] = {"varname", "subsarray", NULL};
+	/* Parsed values are borrowed references, do not Py_DECREF them. */
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &varname_py, &subsarray_py))
+		return NULL;
+	RETURN_IF_INVALID_SEQUENCE(subsarray_py, YDBPython_SubsarraySequence);
+
+	/* Setup for call */
+	INVOKE_ANYSTR_TO_BUFFER(varname_py, varname_ydb, TRUE);
+	INVOKE_POPULATE_SUBS_USED_AND_SUBSARRAY_AND_CLEANUP_VARNAME(subsarray_py, subs_used, subsarray_ydb, varname_ydb);
+	/* Add an empty subscript after the given subscripts to start the iteration at the first child subscript */
+	new_subsarray_ydb = realloc(subsarray_ydb, (subs_used + 1) * sizeof(ydb_buffer_t));
+	if (NULL == new_subsarray_ydb) {
+		FREE_BUFFER_ARRAY(subsarray_ydb, subs_used);
+		YDB_FREE_BUFFER(&varname_ydb);
+		return PyErr_NoMemory();
+	}
+	subsarray_ydb = new_subsarray_ydb;
+	YDB_MALLOC_BUFFER(&subsarray_ydb[subs_used], YDBPY_DEFAULT_SUBSCRIPT_LEN);
+	subs_used++;
+	YDB_MALLOC_BUFFER(&ret_value, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+
+	/* Call the wrapped function until there are no more child subscripts */
+	count = 0;
+	do {
+		status = ydb_subscript_next_s(&varname_ydb, subs_used, subsarray_ydb, &ret_value);
+		if (YDB_ERR_INVSTRLEN == status) {
+			FIX_BUFFER_LENGTH(ret_value);
+			status = ydb_subscript_next_s(&varname_ydb, subs_used, subsarray_ydb, &ret_value);
+			assert(YDB_ERR_INVSTRLEN != status);
+		}
+		if (YDB_OK == status) {
+			count++;
+			/* Use the returned subscript as the starting point of the next call, and reuse the
+			 * buffer of the previous subscript for the next return value.
+			 */
+			swap = subsarray_ydb[subs_used - 1];
+			subsarray_ydb[subs_used - 1] = ret_value;
+			ret_value = swap;
+		}
+	} while (YDB_OK == status);
+	FREE_BUFFER_ARRAY(subsarray_ydb, subs_used);
+	YDB_FREE_BUFFER(&varname_ydb);
+	YDB_FREE_BUFFER(&ret_value);
+
+	if (YDB_ERR_NODEEND != status) {
+		raise_YDBError(status);
+		return NULL;
+	}
+	return PyLong_FromUnsignedLongLong(count); // New Reference
+}
+
+/* Scan the subscripts at the level of the last subscript in `subsarray`, or the variable names if there are no subscripts,
+ * starting after that subscript (or variable name) in the direction given by `reverse`, and return a list of at most `count`
+ * subscripts (or all of them if `count` is 0) that collate between `start` (inclusive) and `stop` (exclusive) and begin
+ * with `prefix`. As with ydb_subscript_next_s(), an empty last subscript starts the scan at the first (or last) subscript.
+ *
+ * The scan seeks directly to `start` or `prefix` (or `stop` or the end of the strings beginning with `prefix`, in reverse)
+ * and ends as soon as a subscript falls outside of the boundaries, so that only the subscripts within the boundaries are read.
+ */
+static PyObject *subscript_scan(PyObject *self, PyObject *args, PyObject *kwds) {
+	int		   count, found, reverse, status, subs_used;
+	unsigned int	   data_value, i;
+	bool		   candidate, done;
+	PyObject *	   varname_py, *subsarray_py, *start_py, *stop_py, *prefix_py;
+	PyObject *	   subscript_py, *ret;
+	ydb_buffer_t	   varname_ydb, ret_value, swap, successor;
+	ydb_buffer_t *	   subsarray_ydb, *cursor;
+	YDBSubscriptBounds bounds;
+
+	UNUSED(self);
+	subs_used = 0;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	subsarray_ydb = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	/* Default values for optional arguments passed from Python */
+	subsarray_py = Py_None;
+	start_py = Py_None;
+	stop_py = Py_None;
+	prefix_py = Py_None;
+	count = 0;
+	reverse = FALSE;
+
+	/* Parse and validate */
+	static char *kwlist[] = {"varname", "subsarray", "start", "stop", "prefix", "count", "reverse", NULL};
+	/* Parsed values are borrowed references, do not Py_DECREF them. */
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOOOip", kwlist, &varname_py, &subsarray_py, &start_py, &stop_py,
+					 &prefix_py, &count, &reverse))
+		return NULL;
+	RETURN_IF_INVALID_SEQUENCE(subsarray_py, YDBPython_SubsarraySequence);
+	if (0 > count) {
+		PyErr_SetString(PyExc_ValueError, "'count' must be a non-negative int");
+		return NULL;
+	}
+
+	/* Setup for call */
+	INVOKE_ANYSTR_TO_BUFFER(varname_py, varname_ydb, TRUE);
+	INVOKE_POPULATE_SUBS_USED_AND_SUBSARRAY_AND_CLEANUP_VARNAME(subsarray_py, subs_used, subsarray_ydb, varname_ydb);
+	if (YDB_OK != populate_subscript_bounds(start_py, stop_py, prefix_py, &bounds)) {
+		FREE_BUFFER_ARRAY(subsarray_ydb, subs_used);
+		YDB_FREE_BUFFER(&varname_ydb);
+		return NULL;
+	}
+	YDB_MALLOC_BUFFER(&ret_value, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+	/* The scan proceeds by replacing the last subscript, or the variable name if there are no subscripts */
+	cursor = (0 < subs_used) ? &subsarray_ydb[subs_used - 1] : &varname_ydb;
+
+	/* Seek to the first subscript within the boundaries */
+	status = YDB_OK;
+	candidate = done = FALSE;
+	if (!reverse) {
+		if ((NULL != bounds.start.buf_addr) && (0 < bounds.start.len_used)
+		    && (0 <= collate_subscripts(&bounds.start, cursor))) {
+			copy_buffer(cursor, &bounds.start);
+			candidate = TRUE;
+		}
+		if ((NULL != bounds.prefix.buf_addr) && !bounds.prefix_may_be_number
+		    && (0 < collate_subscripts(&bounds.prefix, cursor))) {
+			copy_buffer(cursor, &bounds.prefix);
+			candidate = TRUE;
+		}
+	} else {
+		/* In reverse, an empty subscript indicates the end of the subscripts, so nothing precedes an empty `stop` */
+		if (NULL != bounds.stop.buf_addr) {
+			done = (0 == bounds.stop.len_used);
+			if ((0 == cursor->len_used) || (0 > collate_subscripts(&bounds.stop, cursor)))
+				copy_buffer(cursor, &bounds.stop);
+		}
+		if ((NULL != bounds.prefix.buf_addr) && !bounds.prefix_may_be_number) {
+			/* All strings beginning with `prefix` collate before its successor, i.e. the shortest string
+			 * greater than all of them: `prefix` with its last byte that is not 0xFF incremented and any
+			 * following bytes removed. Such a string may be a canonical number, which collates elsewhere,
+			 * so it cannot be used as the starting point of the scan in that case.
+			 */
+			for (i = bounds.prefix.len_used; (0 < i) && (0xFF == (unsigned char)bounds.prefix.buf_addr[i - 1]); i--)
+				;
+			if (0 < i) {
+				YDB_MALLOC_BUFFER(&successor, i);
+				memcpy(successor.buf_addr, bounds.prefix.buf_addr, i);
+				successor.buf_addr[i - 1]++;
+				successor.len_used = i;
+				if (!is_canonical_number(successor.buf_addr, successor.len_used)
+				    && ((0 == cursor->len_used) || (0 > collate_subscripts(&successor, cursor))))
+					copy_buffer(cursor, &successor);
+				YDB_FREE_BUFFER(&successor);
+			}
+		}
+	}
+	if (candidate) {
+		status = ydb_data_s(&varname_ydb, subs_used, subsarray_ydb, &data_value);
+		candidate = (YDB_DATA_UNDEF != data_value);
+	}
+
+	/* Call the wrapped function until a subscript falls outside of the boundaries */
+	ret = PyList_New(0); // New Reference
+	done = done || (NULL == ret);
+	found = 0;
+	while (!done && (YDB_OK == status)) {
+		if (!candidate) {
+			status = subscript_next_or_previous(&varname_ydb, subs_used, subsarray_ydb, &ret_value, reverse);
+			if (YDB_OK != status)
+				break;
+			/* Use the returned subscript as the starting point of the next call, and reuse the
+			 * buffer of the previous subscript for the next return value.
+			 */
+			swap = *cursor;
+			*cursor = ret_value;
+			ret_value = swap;
+		}
+		candidate = FALSE;
+		switch (check_subscript_bounds(cursor, &bounds, reverse)) {
+		case YDBPython_ScanEnd:
+			done = TRUE;
+			break;
+		case YDBPython_ScanMatch:
+			subscript_py = Py_BuildValue("y#", cursor->buf_addr, (Py_ssize_t)cursor->len_used); // New Reference
+			if ((NULL == subscript_py) || (0 != PyList_Append(ret, subscript_py))) {
+				Py_XDECREF(subscript_py);
+				Py_CLEAR(ret);
+				done = TRUE;
+				break;
+			}
+			Py_DECREF(subscript_py);
+			found++;
+			done = (found == count);
+			break;
+		case YDBPython_ScanSkip:
+			break;
+		}
+	}
+	FREE_BUFFER_ARRAY(subsarray_ydb, subs_used);
+	YDB_FREE_BUFFER(&varname_ydb);
+	YDB_FREE_BUFFER(&ret_value);
+	free_subscript_bounds(&bounds);
+
+	if ((YDB_OK != status) && (YDB_ERR_NODEEND != status)) {
+		Py_XDECREF(ret);
+		raise_YDBError(status);
+		return NULL;
+	}
+	return ret;
+}
+
+/* Return the index of the histogram bucket for `n`, i.e. 0 for 0, or 1 + the exponent of the smallest power of two
+ * that is no less than `n`.
+ */
+static int histogram_bucket(unsigned long long n) {
+	int bucket;
+
+	if (0 == n)
+		return 0;
+	for (bucket = 1; (bucket < YDBPY_HISTOGRAM_BUCKETS - 1) && ((1ULL << (bucket - 1)) < n); bucket++)
+		;
+	return bucket;
+}
+
+/* Convert a histogram to a dictionary mapping the upper bound of each non-empty bucket to its count */
+static PyObject *histogram_to_py_dict(unsigned long long *histogram) {
+	int	  bucket;
+	PyObject *ret, *bound, *bucket_count;
+
+	ret = PyDict_New(); // New Reference
+	if (NULL == ret)
+		return NULL;
+	for (bucket = 0; bucket < YDBPY_HISTOGRAM_BUCKETS; bucket++) {
+		if (0 == histogram[bucket])
+			continue;
+		bound = PyLong_FromUnsignedLongLong((0 == bucket) ? 0 : 1ULL << (bucket - 1)); // New Reference
+		bucket_count = PyLong_FromUnsignedLongLong(histogram[bucket]);		       // New Reference
+		if ((NULL == bound) || (NULL == bucket_count) || (0 != PyDict_SetItem(ret, bound, bucket_count))) {
+			Py_XDECREF(bound);
+			Py_XDECREF(bucket_count);
+			Py_DECREF(ret);
+			return NULL;
+		}
+		Py_DECREF(bound);
+		Py_DECREF(bucket_count);
+	}
+	return ret;
+}
+
+/* Return a pseudo-random number between 0 and 1 using the xorshift64* algorithm. Used to sample subtrees
+ * in subtree_stats() with a generator that is independent of the state of the Python random module.
+ */
+static double sample_random(unsigned long long *state) {
+	*state ^= *state >> 12;
+	*state ^= *state << 25;
+	*state ^= *state >> 27;
+	return (double)((*state * 0x2545F4914F6CDD1DULL) >> 11) / (double)(1ULL << 53);
+}
+
+/* Compute statistics for the subtree of a node in C, by traversing it with ydb_node_next_s(): the number of nodes
+ * with a value, the total size of their values, the maximum depth of a node with a value relative to the given
+ * node, a histogram of value sizes, and for each depth a histogram of the number of children of the nodes at that
+ * depth. Histograms are dictionaries mapping the upper bound of each power of two bucket to the number of values or
+ * nodes in that bucket.
+ *
+ * If `sample_rate` is less than 1, each child subtree of the given node is traversed with that probability, and
+ * skipped otherwise, so that statistics can be estimated from a fraction of the subtree. The number of children
+ * of the given node always includes the skipped children. Value sizes are retrieved without copying the values.
+ */
+static PyObject *subtree_stats(PyObject *self, PyObject *args, PyObject *kwds) {
+	int		    depth, node_used, next_used, common, max_depth, status, subs_used, i;
+	unsigned int	    data_value;
+	unsigned long long  seed, nodes, value_bytes;
+	unsigned long long  children[YDB_MAX_SUBS + 1];
+	unsigned long long  value_sizes[YDBPY_HISTOGRAM_BUCKETS];
+	unsigned long long *fanout;
+	double		    sample_rate;
+	bool		    has_value, sampled;
+	PyObject *	    varname_py, *subsarray_py;
+	PyObject *	    fanout_py, *histogram_py, *ret;
+	ydb_buffer_t	    varname_ydb, value_size;
+	ydb_buffer_t *	    subsarray_ydb, *node, *next, *swap;
+
+	UNUSED(self);
+	subs_used = 0;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	subsarray_ydb = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	/* Default values for optional arguments passed from Python */
+	subsarray_py = Py_None;
+	sample_rate = 1.0;
+	seed = 0;
+
+	/* Parse and validate */
+	static char *kwlist[] = {"varname", "subsarray", "sample_rate", "seed", NULL};
+	/* Parsed values are borrowed references, do not Py_DECREF them. */
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OdK", kwlist, &varname_py, &subsarray_py, &sample_rate, &seed))
+		return NULL;
+	RETURN_IF_INVALID_SEQUENCE(subsarray_py, YDBPython_SubsarraySequence);
+	if (!((0.0 < sample_rate) && (1.0 >= sample_rate))) {
+		PyErr_SetString(PyExc_ValueError, "'sample_rate' must be greater than 0 and no greater than 1");
+		return NULL;
+	}
+
+	/* Setup for call */
+	INVOKE_ANYSTR_TO_BUFFER(varname_py, varname_ydb, TRUE);
+	INVOKE_POPULATE_SUBS_USED_AND_SUBSARRAY_AND_CLEANUP_VARNAME(subsarray_py, subs_used, subsarray_ydb, varname_ydb);
+	/* Use two arrays with room for the maximum number of subscripts, for the current node and the node returned by
+	 * ydb_node_next_s(), and swap them after each call to avoid copying subscripts.
+	 */
+	node = create_empty_buffer_array(YDB_MAX_SUBS, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+	next = create_empty_buffer_array(YDB_MAX_SUBS, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+	for (i = 0; i < subs_used; i++)
+		copy_buffer(&node[i], &subsarray_ydb[i]);
+	node_used = subs_used;
+	/* A value buffer with no space, so that ydb_get_s() returns the length of each value with YDB_ERR_INVSTRLEN
+	 * instead of copying it.
+	 */
+	YDB_MALLOC_BUFFER(&value_size, 1);
+	value_size.len_alloc = 0;
+	/* A histogram of the number of children for each depth */
+	fanout = calloc((YDB_MAX_SUBS + 1) * YDBPY_HISTOGRAM_BUCKETS, sizeof(unsigned long long));
+	if (NULL == fanout) {
+		FREE_BUFFER_ARRAY(subsarray_ydb, subs_used);
+		FREE_BUFFER_ARRAY(node, YDB_MAX_SUBS);
+		FREE_BUFFER_ARRAY(next, YDB_MAX_SUBS);
+		YDB_FREE_BUFFER(&varname_ydb);
+		YDB_FREE_BUFFER(&value_size);
+		return PyErr_NoMemory();
+	}
+	memset(value_sizes, 0, sizeof(value_sizes));
+	nodes = value_bytes = 0;
+	max_depth = 0;
+	if (0 == seed)
+		seed = 1; // xorshift requires a non-zero state
+
+	/* The given node is open at depth 0 with no children seen yet, unless it does not exist */
+	children[0] = 0;
+	data_value = YDB_DATA_UNDEF;
+	status = ydb_data_s(&varname_ydb, node_used, node, &data_value);
+	depth = (YDB_DATA_UNDEF == data_value) ? -1 : 0;
+	has_value = (YDB_DATA_VALUE_NODESC == data_value) || (YDB_DATA_VALUE_DESC == data_value);
+	while ((YDB_OK == status) && (0 <= depth)) {
+		if (has_value) {
+			status = ydb_get_s(&varname_ydb, node_used, node, &value_size);
+			if ((YDB_OK == status) || (YDB_ERR_INVSTRLEN == status)) {
+				nodes++;
+				value_bytes += value_size.len_used;
+				value_sizes[histogram_bucket(value_size.len_used)]++;
+				if (max_depth < depth)
+					max_depth = depth;
+				status = YDB_OK;
+			} else if ((YDB_ERR_GVUNDEF == status) || (YDB_ERR_LVUNDEF == status)) {
+				/* The node was deleted, e.g. by another process */
+				status = YDB_OK;
+			} else
+				break;
+		}
+		next_used = YDB_MAX_SUBS;
+		status = ydb_node_next_s(&varname_ydb, node_used, node, &next_used, next);
+		/* If a buffer is not long enough */
+		while (YDB_ERR_INVSTRLEN == status) {
+			FIX_BUFFER_LENGTH(next[next_used]);
+			next_used = YDB_MAX_SUBS;
+			status = ydb_node_next_s(&varname_ydb, node_used, node, &next_used, next);
+		}
+		if (YDB_OK != status)
+			break;
+		if ((next_used <= subs_used) || (0 != collate_subsarrays(next, subs_used, subsarray_ydb, subs_used)))
+			break;
+		/* Close the nodes of the previous node's path that are not on the path of the next node, recording their
+		 * number of children, then open the nodes on the path of the next node below the common ancestor.
+		 */
+		for (common = subs_used; (common < node_used) && (common < next_used); common++) {
+			if ((node[common].len_used != next[common].len_used)
+			    || (0 != memcmp(node[common].buf_addr, next[common].buf_addr, node[common].len_used)))
+				break;
+		}
+		for (; depth > common - subs_used; depth--)
+			fanout[depth * YDBPY_HISTOGRAM_BUCKETS + histogram_bucket(children[depth])]++;
+		swap = node;
+		node = next;
+		next = swap;
+		node_used = next_used;
+		has_value = TRUE;
+		sampled = (0 < depth) || (1.0 <= sample_rate) || (sample_random(&seed) < sample_rate);
+		while (!sampled) {
+			/* Skip the subtree of this child of the given node, moving on to the next child */
+			children[0]++;
+			node_used = subs_used + 1;
+			status = subscript_next_or_previous(&varname_ydb, node_used, node, &next[0], FALSE);
+			if (YDB_OK != status) {
+				/* There are no more children, and the skipped child has already been counted */
+				node_used = subs_used;
+				break;
+			}
+			copy_buffer(&node[subs_used], &next[0]);
+			sampled = (sample_random(&seed) < sample_rate);
+			/* The next child may not have a value, in which case its first descendant with a value follows it */
+			if (sampled) {
+				status = ydb_data_s(&varname_ydb, node_used, node, &data_value);
+				has_value = (YDB_DATA_VALUE_NODESC == data_value) || (YDB_DATA_VALUE_DESC == data_value);
+			}
+		}
+		for (; depth < node_used - subs_used; depth++) {
+			children[depth]++;
+			children[depth + 1] = 0;
+		}
+	}
+	/* Close the nodes of the last node's path, including the given node */
+	for (; 0 <= depth; depth--)
+		fanout[depth * YDBPY_HISTOGRAM_BUCKETS + histogram_bucket(children[depth])]++;
+	FREE_BUFFER_ARRAY(subsarray_ydb, subs_used);
+	FREE_BUFFER_ARRAY(node, YDB_MAX_SUBS);
+	FREE_BUFFER_ARRAY(next, YDB_MAX_SUBS);
+	YDB_FREE_BUFFER(&varname_ydb);
+	YDB_FREE_BUFFER(&value_size);
+
+	if ((YDB_OK != status) && (YDB_ERR_NODEEND != status)) {
+		free(fanout);
+		raise_YDBError(status);
+		return NULL;
+	}
+	/* Only report the depths that have nodes */
+	fanout_py = PyList_New(0); // New Reference
+	for (i = 0; (NULL != fanout_py) && (i <= YDB_MAX_SUBS); i++) {
+		histogram_py = histogram_to_py_dict(&fanout[i * YDBPY_HISTOGRAM_BUCKETS]); // New Reference
+		if (NULL == histogram_py) {
+			Py_CLEAR(fanout_py);
+			break;
+		}
+		if (0 == PyDict_Size(histogram_py)) {
+			Py_DECREF(histogram_py);
+			break;
+		}
+		if (0 != PyList_Append(fanout_py, histogram_py))
+			Py_CLEAR(fanout_py);
+		Py_DECREF(histogram_py);
+	}
+	free(fanout);
+	if (NULL == fanout_py)
+		return NULL;
+	histogram_py = histogram_to_py_dict(value_sizes); // New Reference
+	if (NULL == histogram_py) {
+		Py_DECREF(fanout_py);
+		return NULL;
+	}
+	/* Steal the references to the histograms */
+	ret = Py_BuildValue("{s:K,s:K,s:i,s:N,s:N,s:d}", "nodes", nodes, "value_bytes", value_bytes, "max_depth", max_depth,
+			    "value_sizes", histogram_py, "fanout", fanout_py, "sample_rate", sample_rate);
+	return ret;
+}
+
+/* Free the buffers of a YDBTemplate and the struct itself. The placeholder buffers point to the params of the last call,
+ * which are owned by Python objects, so they are not freed.
+ */
+static void free_template_buffers(YDBTemplate *template) {
+	int i;
+
+	for (i = 0; i < template->num_params; i++) {
+		template->subsarray[template->params[i]].buf_addr = NULL;
+	}
+	for (i = 0; i < template->subs_used; i++) {
+		YDB_FREE_BUFFER(&template->subsarray[i]);
+	}
+	YDB_FREE_BUFFER(&template->varname);
+	free(template);
+}
+
+/* Destructor of the PyCapsule objects returned by template() */
+static void free_template(PyObject *capsule) {
+	free_template_buffers(PyCapsule_GetPointer(capsule, YDBPY_TEMPLATE_CAPSULE));
+}
+
+/* Get the YDBTemplate held by a PyCapsule returned by template(), and point its placeholder buffers to the bytes, or the
+ * UTF-8 encoding cached by the str objects, in the params tuple. The params must stay referenced until the template is
+ * used, and the caller must hold api_lock until then, since the template may be shared by several threads.
+ */
+static YDBTemplate *fill_template(PyObject *capsule, PyObject *params) {
+	YDBTemplate * template;
+	ydb_buffer_t *buffer;
+	PyObject *    item;
+	Py_ssize_t    i, len;
+	const char *  addr;
+
+	template = PyCapsule_GetPointer(capsule, YDBPY_TEMPLATE_CAPSULE);
+	if (NULL == template) {
+		return NULL;
+	}
+	if (!PyTuple_Check(params)) {
+		raise_ValidationError(YDBPython_TypeError, YDBPY_ERR_PARAMS_INVALID, YDBPY_ERR_NOT_LIST_OR_TUPLE);
+		return NULL;
+	}
+	if (template->num_params != PyTuple_GET_SIZE(params)) {
+		raise_ValidationError(YDBPython_ValueError, NULL, YDBPY_ERR_TEMPLATE_PARAMS, template->num_params,
+				      PyTuple_GET_SIZE(params));
+		return NULL;
+	}
+	for (i = 0; i < template->num_params; i++) {
+		item = PyTuple_GET_ITEM(params, i); // Borrowed Reference
+		if (PyBytes_Check(item)) {
+			addr = PyBytes_AS_STRING(item);
+			len = PyBytes_GET_SIZE(item);
+		} else if (PyUnicode_Check(item)) {
+			addr = str_to_utf8(item, &len);
+			if (NULL == addr) {
+				return NULL;
+			}
+		} else {
+			raise_ValidationError(YDBPython_TypeError, YDBPY_ERR_PARAMS_INVALID, YDBPY_ERR_ITEM_NOT_BYTES_LIKE, i);
+			return NULL;
+		}
+		if (YDB_MAX_STR < len) {
+			raise_ValidationError(YDBPython_ValueError, YDBPY_ERR_PARAMS_INVALID, YDBPY_ERR_BYTES_TOO_LONG, len,
+					      YDB_MAX_STR);
+			return NULL;
+		}
+		// YottaDB does not modify subscripts, so the buffer may point to the immutable data of the Python object
+		buffer = &template->subsarray[template->params[i]];
+		buffer->buf_addr = (char *)addr;
+		buffer->len_alloc = buffer->len_used = (unsigned int)len;
+	}
+	return template;
+}
+
+/* Prepare a node for repeated access by template_get(), template_set() and template_incr(). Each None subscript is a
+ * placeholder that is filled by a param on each call, while the variable name and all other subscripts are validated
+ * and converted to buffers only once. Returns a PyCapsule that owns the resulting YDBTemplate.
+ */
+static PyObject *template(PyObject *self, PyObject *args, PyObject *kwds) {
+	PyObject *   varname_py, *subsarray_py, *seq, *item, *ret;
+	YDBTemplate *template;
+	Py_ssize_t   i, len;
+
+	UNUSED(self);
+	/* Default values for optional arguments passed from Python */
+	subsarray_py = Py_None;
+
+	/* Parse and validate */
+	static char *kwlist[] = {"varname", "subsarray", NULL};
+	/* Parsed values are borrowed references, do not Py_DECREF them. */
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &varname_py, &subsarray_py)) {
+		return NULL;
+	}
+	if (Py_None == subsarray_py) {
+		seq = PyTuple_New(0); // New Reference
+	} else if (PyTuple_Check(subsarray_py) || PyList_Check(subsarray_py)) {
+		seq = PySequence_Fast(subsarray_py, "argument must be iterable"); // New Reference
+	} else {
+		raise_ValidationError(YDBPython_TypeError, YDBPY_ERR_SUBSARRAY_INVALID, YDBPY_ERR_NOT_LIST_OR_TUPLE);
+		return NULL;
+	}
+	if (NULL == seq) {
+		return NULL;
+	}
+	len = PySequence_Fast_GET_SIZE(seq);
+	if (YDB_MAX_SUBS < len) {
+		raise_ValidationError(YDBPython_ValueError, YDBPY_ERR_SUBSARRAY_INVALID, YDBPY_ERR_SEQUENCE_TOO_LONG, len,
+				      YDB_MAX_SUBS);
+		DECREF_AND_RETURN(seq, NULL);
+	}
+
+	/* Convert the variable name and constant subscripts */
+	template = calloc(1, sizeof(YDBTemplate));
+	if (NULL == template) {
+		Py_DECREF(seq);
+		return PyErr_NoMemory();
+	}
+	if (YDB_OK != anystr_to_buffer(varname_py, &template->varname, TRUE)) {
+		free(template);
+		DECREF_AND_RETURN(seq, NULL);
+	}
+	for (i = 0; i < len; i++) {
+		template->subs_used = (int)i;
+		item = PySequence_Fast_GET_ITEM(seq, i); // Borrowed Reference
+		if (Py_None == item) {
+			template->params[template->num_params] = (int)i;
+			template->num_params++;
+		} else if (YDB_OK != anystr_to_buffer(item, &template->subsarray[i], FALSE)) {
+			free_template_buffers(template);
+			DECREF_AND_RETURN(seq, NULL);
+		}
+	}
+	template->subs_used = (int)len;
+	Py_DECREF(seq);
+
+	ret = PyCapsule_New(template, YDBPY_TEMPLATE_CAPSULE, free_template); // New Reference
+	if (NULL == ret) {
+		free_template_buffers(template);
+	}
+	return ret;
+}
+
+/* Wrapper for ydb_get_s() on a node prepared by template(), of which the placeholder subscripts are given by params */
+static PyObject *template_get(PyObject *self, PyObject *args, PyObject *kwds) {
+	int	     status;
+	PyObject *   capsule, *params, *ret;
+	YDBTemplate *template;
+	ydb_buffer_t ret_value;
+
+	UNUSED(self);
+
+	/* Parse and validate */
+	static char *kwlist[] = {"template", "params", NULL};
+	/* Parsed values are borrowed references, do not Py_DECREF them. */
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO", kwlist, &capsule, &params)) {
+		return NULL;
+	}
+	template = fill_template(capsule, params);
+	if (NULL == template) {
+		return NULL;
+	}
+	YDB_MALLOC_BUFFER(&ret_value, YDBPY_DEFAULT_VALUE_LEN);
+
+	/* Call the wrapped function */
+	status = ydb_get_s(&template->varname, template->subs_used, template->subsarray, &ret_value);
+	/* Check to see if length of string was longer than YDBPY_DEFAULT_VALUE_LEN. If so, try again
+	 * with proper length */
+	if (YDB_ERR_INVSTRLEN == status) {
+		FIX_BUFFER_LENGTH(ret_value);
+		/* Call the wrapped function */
+		status = ydb_get_s(&template->varname, template->subs_used, template->subsarray, &ret_value);
+		assert(YDB_ERR_INVSTRLEN != status);
+	}
+	if (YDB_OK != status) {
+		if ((YDB_ERR_GVUNDEF == status) || (YDB_ERR_LVUNDEF == status)) {
+			Py_INCREF(Py_None);
+			ret = Py_None;
+		} else {
+			raise_YDBError(status);
+			ret = NULL;
+		}
+	} else {
+		/* New Reference */
+		ret = Py_BuildValue("y#", ret_value.buf_addr, (Py_ssize_t)ret_value.len_used);
+	}
+	YDB_FREE_BUFFER(&ret_value);
+	return ret;
+}
+
+/* Wrapper for ydb_incr_s() on a node prepared by template(), of which the placeholder subscripts are given by params */
+static PyObject *template_incr(PyObject *self, PyObject *args, PyObject *kwds) {
+	int	     status;
+	PyObject *   capsule, *params, *increment_py, *ret;
+	YDBTemplate *template;
+	ydb_buffer_t increment_ydb, ret_value;
+
+	UNUSED(self);
+	/* Default values for optional arguments passed from Python */
+	increment_py = Py_None;
+
+	/* Parse and validate */
+	static char *kwlist[] = {"template", "params", "increment", NULL};
+	/* Parsed values are borrowed references, do not Py_DECREF them. */
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|O", kwlist, &capsule, &params, &increment_py)) {
+		return NULL;
+	}
+	template = fill_template(capsule, params);
+	if (NULL == template) {
+		return NULL;
+	}
+	if (Py_None == increment_py) {
+		// No value was specified, or it was None, so increment by a default of 1.
+		YDB_MALLOC_BUFFER(&increment_ydb, YDBPY_DEFAULT_VALUE_LEN);
+		increment_ydb.len_used = snprintf(increment_ydb.buf_addr, YDBPY_DEFAULT_VALUE_LEN, "1");
+	} else if (YDB_OK != anystr_to_buffer(increment_py, &increment_ydb, FALSE)) {
+		return NULL;
+	}
+	YDB_MALLOC_BUFFER(&ret_value, CANONICAL_NUMBER_TO_STRING_MAX);
+
+	/* Call the wrapped function */
+	status = ydb_incr_s(&template->varname, template->subs_used, template->subsarray, &increment_ydb, &ret_value);
+	YDB_FREE_BUFFER(&increment_ydb);
+	if (YDB_OK != status) {
+		raise_YDBError(status);
+		ret = NULL;
+	} else {
+		/* Create Python object to return. Creates a new reference */
+		ret = Py_BuildValue("y#", ret_value.buf_addr, (Py_ssize_t)ret_value.len_used);
+	}
+	YDB_FREE_BUFFER(&ret_value);
+	return ret;
+}
+
+/* Wrapper for ydb_set_s() on a node prepared by template(), of which the placeholder subscripts are given by params */
+static PyObject *template_set(PyObject *self, PyObject *args, PyObject *kwds) {
+	int	     status;
+	PyObject *   capsule, *params, *value_py;
+	YDBTemplate *template;
+	ydb_buffer_t value_ydb;
+
+	UNUSED(self);
+	/* Default values for optional arguments passed from Python */
+	value_py = Py_None;
+
+	/* Parse and validate */
+	static char *kwlist[] = {"template", "params", "value", NULL};
+	/* Parsed values are borrowed references, do not Py_DECREF them. */
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|O", kwlist, &capsule, &params, &value_py)) {
+		return NULL;
+	}
+	template = fill_template(capsule, params);
+	if (NULL == template) {
+		return NULL;
+	}
+	if (Py_None == value_py) {
+		// No value was specified, or it was None, so set node to empty string.
+		YDB_MALLOC_BUFFER(&value_ydb, YDBPY_DEFAULT_VALUE_LEN);
+		value_ydb.buf_addr[0] = '\0';
+		value_ydb.len_used = 0;
+	} else if (YDB_OK != anystr_to_buffer(value_py, &value_ydb, FALSE)) {
+		return NULL;
+	}
 
-	/* Check status for Errors and Raise Exception */
+	/* Call the wrapped function */
+	status = ydb_set_s(&template->varname, template->subs_used, template->subsarray, &value_ydb);
+	YDB_FREE_BUFFER(&value_ydb);
 	if (YDB_OK != status) {
 		raise_YDBError(status);
-	} else {
-		/* Create Python object to return. Creates a new reference */
-		ret = Py_BuildValue("y#", ret_value.buf_addr, (Py_ssize_t)ret_value.len_used);
+		return NULL;
 	}
-	YDB_FREE_BUFFER(&ret_value);
-	return ret;
+	Py_INCREF(Py_None);
+	return Py_None;
 }
 
 /* Callback functions used by Wrapper for ydb_tp_s() */
@@ -2090,43 +4768,36 @@ static PyObject *subscript_previous(PyObject *self, PyObject *args, PyObject *kw
  *      1) This is the callback function that is always passed to the ydb_tp_st
  *              Simple API function and should only ever be called by ydb_tp_st
  *              via tp() below. It assumes that everything passed to it was validated.
- *      2) The actual Python function to be called is passed to this function
- *              as the first element in a Python tuple.
- *      3) The positional arguments are passed as the second element and the
- *              keyword args are passed as the third.
- *      4) This function calls calls the Python callback function with the args and
- *              kwargs arguments.
+ *      2) The actual Python function to be called, and its positional and keyword
+ *              arguments, are passed to this function in a YDBTPCallback struct.
+ *      3) This function calls the Python callback function with vectorcall, directly
+ *              from the items of the args tuple, so that no objects are allocated on
+ *              each attempt of the transaction.
+ *      4) A callback that returns None returns YDB_OK, so that a callback without an
+ *              explicit return statement commits the transaction.
  *      5) if a function raises an exception then this function returns TPCALLBACKINVRETVAL
  *              as a way of indicating an error.
  *      Note: the PyErr String is already set so the the function receiving the return
  *              value (tp()) just needs to return NULL.
  */
-static int callback_wrapper(void *function_with_arguments) {
-	int	  ret_value;
-	bool	  decref_args = false;
-	bool	  decref_kwargs = false;
-	PyObject *function, *args, *kwargs, *ret;
-	PyObject *err_object;
-
-	function = PyTuple_GetItem(function_with_arguments, 0); // Borrowed Reference
-	args = PyTuple_GetItem(function_with_arguments, 1);	// Borrowed Reference
-	kwargs = PyTuple_GetItem(function_with_arguments, 2);	// Borrowed Reference
-
-	if (Py_None == args) {
-		args = PyTuple_New(0);
-		decref_args = true;
-	}
-	if (Py_None == kwargs) {
-		kwargs = PyDict_New();
-		decref_kwargs = true;
+static int callback_wrapper(void *tp_callback_ptr) {
+	int		  ret_value;
+	YDBTPCallback *	  tp_callback;
+	PyObject *	  ret;
+	PyObject *	  err_object;
+	PyObject *const *items;
+	Py_ssize_t	  nargs;
+
+	tp_callback = tp_callback_ptr;
+	if (NULL == tp_callback->args) {
+		items = NULL;
+		nargs = 0;
+	} else {
+		items = &PyTuple_GET_ITEM(tp_callback->args, 0);
+		nargs = PyTuple_GET_SIZE(tp_callback->args);
 	}
 
-	ret = PyObject_Call(function, args, kwargs); // New Reference
-
-	if (decref_args)
-		Py_DECREF(args);
-	if (decref_kwargs)
-		Py_DECREF(kwargs);
+	ret = PyObject_VectorcallDict(tp_callback->callback, items, nargs, tp_callback->kwargs); // New Reference
 
 	if (NULL == ret) {
 		/* No return value was specified, signalling that `function` raised an exception.
@@ -2142,10 +4813,10 @@ static int callback_wrapper(void *function_with_arguments) {
 		 * This should not happen, so assert that here.
 		 */
 		assert(err_object);
-		if (PyErr_GivenExceptionMatches(err_object, YDBTPRestart)) {
+		if (PyErr_GivenExceptionMatches(err_object, module_state->YDBTPRestart)) {
 			PyErr_Clear();
 			return YDB_TP_RESTART;
-		} else if (PyErr_GivenExceptionMatches(err_object, YDBTPRollback)) {
+		} else if (PyErr_GivenExceptionMatches(err_object, module_state->YDBTPRollback)) {
 			PyErr_Clear();
 			return YDB_TP_ROLLBACK;
 		} else {
@@ -2155,8 +4826,12 @@ static int callback_wrapper(void *function_with_arguments) {
 			 */
 			return YDB_ERR_TPCALLBACKINVRETVAL;
 		}
+	} else if (Py_None == ret) {
+		Py_DECREF(ret);
+		return YDB_OK;
 	} else if (!PyLong_Check(ret)) {
-		PyErr_SetString(PyExc_TypeError, "Callback function must return value of type int.");
+		Py_DECREF(ret);
+		PyErr_SetString(PyExc_TypeError, "Callback function must return value of type int or None.");
 		return YDB_ERR_TPCALLBACKINVRETVAL;
 	}
 	ret_value = (int)PyLong_AsLong(ret);
@@ -2169,8 +4844,9 @@ static PyObject *tp(PyObject *self, PyObject *args, PyObject *kwds) {
 	bool	      return_null = false;
 	int	      namecount, status;
 	char *	      transid;
-	PyObject *    callback, *callback_args, *callback_kwargs, *varnames_py, *function_with_arguments;
+	PyObject *    callback, *callback_args, *callback_kwargs, *varnames_py;
 	ydb_buffer_t *varnames_ydb;
+	YDBTPCallback tp_callback;
 
 	UNUSED(self);
 	/* Default values for optional arguments passed from Python */
@@ -2206,9 +4882,11 @@ static PyObject *tp(PyObject *self, PyObject *args, PyObject *kwds) {
 	}
 	RETURN_IF_INVALID_SEQUENCE(varnames_py, YDBPython_VarnameSequence);
 	if (!return_null) {
-		/* Setup for Call */
-		/* New Reference */
-		function_with_arguments = Py_BuildValue("(OOO)", callback, callback_args, callback_kwargs);
+		/* Setup for Call. The arguments are only used during the call, so their references are borrowed. */
+		tp_callback.callback = callback;
+		tp_callback.args = ((Py_None == callback_args) || (0 == PyTuple_GET_SIZE(callback_args))) ? NULL : callback_args;
+		tp_callback.kwargs
+		    = ((Py_None == callback_kwargs) || (0 == PyDict_GET_SIZE(callback_kwargs))) ? NULL : callback_kwargs;
 		if (Py_None != varnames_py)
 			namecount = PySequence_Length(varnames_py);
 
@@ -2216,7 +4894,6 @@ static PyObject *tp(PyObject *self, PyObject *args, PyObject *kwds) {
 			varnames_ydb = (ydb_buffer_t *)malloc(namecount * sizeof(ydb_buffer_t));
 			status = convert_py_sequence_to_ydb_buffer_array(varnames_py, namecount, varnames_ydb);
 			if (YDB_OK != status) {
-				Py_DECREF(function_with_arguments);
 				return NULL;
 			}
 		} else {
@@ -2224,7 +4901,7 @@ static PyObject *tp(PyObject *self, PyObject *args, PyObject *kwds) {
 		}
 
 		/* Call the wrapped function */
-		status = ydb_tp_s(callback_wrapper, function_with_arguments, transid, namecount, varnames_ydb);
+		status = ydb_tp_s(callback_wrapper, &tp_callback, transid, namecount, varnames_ydb);
 		/* Check status for errors and raise exception */
 		if (YDB_ERR_TPCALLBACKINVRETVAL == status) {
 			// Exception already raised in callback_wrapper
@@ -2234,7 +4911,6 @@ static PyObject *tp(PyObject *self, PyObject *args, PyObject *kwds) {
 			return_null = true;
 		}
 		/* Free allocated memory */
-		Py_DECREF(function_with_arguments);
 		FREE_BUFFER_ARRAY(varnames_ydb, namecount);
 	}
 
@@ -2245,6 +4921,511 @@ static PyObject *tp(PyObject *self, PyObject *args, PyObject *kwds) {
 	}
 }
 
+/* Names of the operations that may be passed to atomic(), and the minimum and maximum lengths of their
+ * (op, varname, subsarray, ...) tuples
+ */
+static const struct {
+	char *		      name;
+	YDBPythonAtomicOpType type;
+	int		      min_len;
+	int		      max_len;
+} atomic_op_names[] = {
+    {"get", YDBPython_AtomicGet, 2, 3},
+    {"set", YDBPython_AtomicSet, 2, 4},
+    {"incr", YDBPython_AtomicIncr, 2, 4},
+    {"delete", YDBPython_AtomicDelete, 2, 3},
+    {"delete_tree", YDBPython_AtomicDeleteTree, 2, 3},
+    {"data", YDBPython_AtomicData, 2, 3},
+    {"compare_and_set", YDBPython_AtomicCompareAndSet, 5, 5},
+};
+
+/* Read the value of the node of an atomic() operation into its result buffer, reallocating the buffer if it is too short */
+static int atomic_get(YDBAtomicOp *op) {
+	int status;
+
+	status = ydb_get_s(&op->varname, op->subs_used, op->subsarray, &op->result);
+	if (YDB_ERR_INVSTRLEN == status) {
+		FIX_BUFFER_LENGTH(op->result);
+		status = ydb_get_s(&op->varname, op->subs_used, op->subsarray, &op->result);
+		assert(YDB_ERR_INVSTRLEN != status);
+	}
+	op->has_result = (YDB_OK == status);
+	if ((YDB_ERR_GVUNDEF == status) || (YDB_ERR_LVUNDEF == status)) {
+		status = YDB_OK;
+	}
+	return status;
+}
+
+/* Transaction callback of atomic(). Unlike callback_wrapper(), it does not call into Python, so it runs, and is restarted,
+ * without the GIL. A compare_and_set operation that does not find its expected value rolls back the transaction.
+ */
+static int atomic_callback(void *batch_ptr) {
+	YDBAtomicBatch *batch;
+	YDBAtomicOp *	op;
+	int		i, status;
+	bool		matches;
+
+	batch = batch_ptr;
+	batch->mismatch = -1;
+	for (i = 0; i < batch->num_ops; i++) {
+		op = &batch->ops[i];
+		switch (op->type) {
+		case YDBPython_AtomicGet:
+			status = atomic_get(op);
+			break;
+		case YDBPython_AtomicSet:
+			status = ydb_set_s(&op->varname, op->subs_used, op->subsarray, &op->value);
+			break;
+		case YDBPython_AtomicIncr:
+			status = ydb_incr_s(&op->varname, op->subs_used, op->subsarray, &op->value, &op->result);
+			break;
+		case YDBPython_AtomicDelete:
+			status = ydb_delete_s(&op->varname, op->subs_used, op->subsarray, YDB_DEL_NODE);
+			break;
+		case YDBPython_AtomicDeleteTree:
+			status = ydb_delete_s(&op->varname, op->subs_used, op->subsarray, YDB_DEL_TREE);
+			break;
+		case YDBPython_AtomicData:
+			status = ydb_data_s(&op->varname, op->subs_used, op->subsarray, &op->data);
+			break;
+		case YDBPython_AtomicCompareAndSet:
+			status = atomic_get(op);
+			if (YDB_OK != status) {
+				break;
+			}
+			if (op->has_value) {
+				matches = op->has_result && (op->value.len_used == op->result.len_used)
+					  && (0 == memcmp(op->value.buf_addr, op->result.buf_addr, op->value.len_used));
+			} else {
+				matches = !op->has_result;
+			}
+			if (!matches) {
+				batch->mismatch = i;
+				return YDB_TP_ROLLBACK;
+			}
+			if (op->has_new_value) {
+				status = ydb_set_s(&op->varname, op->subs_used, op->subsarray, &op->new_value);
+			} else if (op->has_result) {
+				status = ydb_delete_s(&op->varname, op->subs_used, op->subsarray, YDB_DEL_NODE);
+			}
+			break;
+		default:
+			assert(FALSE);
+			status = YDB_ERR_TPCALLBACKINVRETVAL;
+			break;
+		}
+		if (YDB_OK != status) {
+			return status;
+		}
+	}
+	return YDB_OK;
+}
+
+/* Free the buffers of the first `num_ops` operations of an atomic() call, and the operations themselves */
+static void free_atomic_ops(YDBAtomicOp *ops, int num_ops) {
+	YDBAtomicOp *op;
+
+	// FREE_BUFFER_ARRAY declares its own loop index, so do not index ops inside it
+	for (op = ops; op < &ops[num_ops]; op++) {
+		YDB_FREE_BUFFER(&op->varname);
+		FREE_BUFFER_ARRAY(op->subsarray, op->subs_used);
+		YDB_FREE_BUFFER(&op->value);
+		YDB_FREE_BUFFER(&op->new_value);
+		YDB_FREE_BUFFER(&op->result);
+	}
+	free(ops);
+}
+
+/* Validate an (op, varname, subsarray, ...) tuple passed to atomic() and convert it to the YDBAtomicOp `op`, which is zeroed
+ * by the caller. Returns YDB_OK on success, or raises an exception and returns !YDB_OK after freeing any buffers of `op`.
+ */
+static int load_atomic_op(PyObject *item, Py_ssize_t index, YDBAtomicOp *op) {
+	PyObject *  seq, *name_py, *subsarray_py, *value_py, *new_value_py;
+	Py_ssize_t  len;
+	const char *name;
+	size_t	    i;
+	int	    status;
+
+	if (!PyTuple_Check(item) && !PyList_Check(item)) {
+		raise_ValidationError(YDBPython_TypeError, YDBPY_ERR_OPS_INVALID, YDBPY_ERR_NODE_IN_SEQUENCE_NOT_LIST_OR_TUPLE,
+				      index);
+		return !YDB_OK;
+	}
+	seq = PySequence_Fast(item, "argument must be iterable"); // New Reference
+	if (NULL == seq) {
+		return !YDB_OK;
+	}
+	len = PySequence_Fast_GET_SIZE(seq);
+	name_py = (0 < len) ? PySequence_Fast_GET_ITEM(seq, 0) : Py_None; // Borrowed Reference
+	name = PyUnicode_Check(name_py) ? PyUnicode_AsUTF8(name_py) : NULL;
+	if (NULL == name) {
+		PyErr_Clear();
+		raise_ValidationError(YDBPython_TypeError, YDBPY_ERR_OPS_INVALID, YDBPY_ERR_OP_UNKNOWN, index, "");
+		DECREF_AND_RETURN(seq, !YDB_OK);
+	}
+	for (i = 0; i < sizeof(atomic_op_names) / sizeof(atomic_op_names[0]); i++) {
+		if (0 == strcmp(name, atomic_op_names[i].name)) {
+			break;
+		}
+	}
+	if (sizeof(atomic_op_names) / sizeof(atomic_op_names[0]) == i) {
+		raise_ValidationError(YDBPython_ValueError, YDBPY_ERR_OPS_INVALID, YDBPY_ERR_OP_UNKNOWN, index, name);
+		DECREF_AND_RETURN(seq, !YDB_OK);
+	}
+	if ((atomic_op_names[i].min_len > len) || (atomic_op_names[i].max_len < len)) {
+		raise_ValidationError(YDBPython_ValueError, YDBPY_ERR_OPS_INVALID, YDBPY_ERR_OP_INCORRECT_LENGTH, index,
+				      atomic_op_names[i].min_len, atomic_op_names[i].max_len, name);
+		DECREF_AND_RETURN(seq, !YDB_OK);
+	}
+	op->type = atomic_op_names[i].type;
+	subsarray_py = (2 < len) ? PySequence_Fast_GET_ITEM(seq, 2) : Py_None;	// Borrowed Reference
+	value_py = (3 < len) ? PySequence_Fast_GET_ITEM(seq, 3) : Py_None;	// Borrowed Reference
+	new_value_py = (4 < len) ? PySequence_Fast_GET_ITEM(seq, 4) : Py_None; // Borrowed Reference
+	if (!is_valid_sequence(subsarray_py, YDBPython_SubsarraySequence, NULL)) {
+		DECREF_AND_RETURN(seq, !YDB_OK);
+	}
+
+	/* Convert the node, and the value, increment or expected value, and new value of the operation */
+	status = anystr_to_buffer(PySequence_Fast_GET_ITEM(seq, 1), &op->varname, TRUE);
+	if (YDB_OK == status) {
+		status = populate_subs_used_and_subsarray(subsarray_py, &op->subs_used, &op->subsarray);
+		if (YDB_OK != status) {
+			op->subsarray = NULL;
+		}
+	}
+	if ((YDB_OK == status) && (Py_None != value_py)) {
+		status = anystr_to_buffer(value_py, &op->value, FALSE);
+		op->has_value = (YDB_OK == status);
+	}
+	if ((YDB_OK == status) && (Py_None != new_value_py)) {
+		status = anystr_to_buffer(new_value_py, &op->new_value, FALSE);
+		op->has_new_value = (YDB_OK == status);
+	}
+	Py_DECREF(seq);
+	if (YDB_OK != status) {
+		YDB_FREE_BUFFER(&op->varname);
+		FREE_BUFFER_ARRAY(op->subsarray, op->subs_used);
+		YDB_FREE_BUFFER(&op->value);
+		return status;
+	}
+
+	/* Fill in defaults and allocate result buffers */
+	switch (op->type) {
+	case YDBPython_AtomicSet:
+		if (!op->has_value) {
+			// No value was specified, or it was None, so set node to empty string.
+			YDB_MALLOC_BUFFER(&op->value, YDBPY_DEFAULT_VALUE_LEN);
+			op->value.len_used = 0;
+		}
+		break;
+	case YDBPython_AtomicIncr:
+		if (!op->has_value) {
+			// No increment was specified, or it was None, so increment by a default of 1.
+			YDB_MALLOC_BUFFER(&op->value, YDBPY_DEFAULT_VALUE_LEN);
+			op->value.len_used = snprintf(op->value.buf_addr, YDBPY_DEFAULT_VALUE_LEN, "1");
+		}
+		YDB_MALLOC_BUFFER(&op->result, CANONICAL_NUMBER_TO_STRING_MAX);
+		break;
+	case YDBPython_AtomicGet:
+	case YDBPython_AtomicCompareAndSet:
+		YDB_MALLOC_BUFFER(&op->result, YDBPY_DEFAULT_VALUE_LEN);
+		break;
+	default:
+		break;
+	}
+	return YDB_OK;
+}
+
+/* Execute a sequence of (op, varname, subsarray, ...) operations in a single ydb_tp_s() transaction, using a C callback
+ * instead of a Python one, so that neither the transaction nor its restarts run Python code or hold the GIL. The
+ * operations, and their arguments after the node, are:
+ *    ("get", varname, subsarray)                                -> value, or None if the node has no value
+ *    ("set", varname, subsarray, value)                         -> None
+ *    ("incr", varname, subsarray, increment)                    -> new value
+ *    ("delete", varname, subsarray)                             -> None
+ *    ("delete_tree", varname, subsarray)                        -> None
+ *    ("data", varname, subsarray)                               -> result of ydb_data_s()
+ *    ("compare_and_set", varname, subsarray, expected, new)     -> None
+ * A None expected value requires the node to have no value, and a None new value deletes the node. If a compare_and_set
+ * operation does not find its expected value, the transaction is rolled back and None is returned instead of the list of
+ * results.
+ */
+static PyObject *atomic(PyObject *self, PyObject *args, PyObject *kwds) {
+	int	       namecount, status, i;
+	char *	       transid;
+	PyObject *     ops_py, *varnames_py, *seq, *ret, *result;
+	ydb_buffer_t * varnames_ydb;
+	YDBAtomicBatch batch;
+	YDBAtomicOp *  op;
+
+	UNUSED(self);
+	/* Default values for optional arguments passed from Python */
+	transid = "";
+	namecount = 0;
+	varnames_py = Py_None;
+
+	/* Parse and validate */
+	static char *kwlist[] = {"ops", "transid", "varnames", NULL};
+	/* Parsed values are borrowed references, do not Py_DECREF them. */
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sO", kwlist, &ops_py, &transid, &varnames_py)) {
+		return NULL;
+	}
+	if (!PyTuple_Check(ops_py) && !PyList_Check(ops_py)) {
+		raise_ValidationError(YDBPython_TypeError, YDBPY_ERR_OPS_INVALID, YDBPY_ERR_NOT_LIST_OR_TUPLE);
+		return NULL;
+	}
+	RETURN_IF_INVALID_SEQUENCE(varnames_py, YDBPython_VarnameSequence);
+	seq = PySequence_Fast(ops_py, "argument must be iterable"); // New Reference
+	if (NULL == seq) {
+		return NULL;
+	}
+	batch.num_ops = (int)PySequence_Fast_GET_SIZE(seq);
+	batch.mismatch = -1;
+	batch.ops = calloc(batch.num_ops + 1, sizeof(YDBAtomicOp)); // + 1 to avoid a 0-byte allocation
+	if (NULL == batch.ops) {
+		Py_DECREF(seq);
+		return PyErr_NoMemory();
+	}
+	for (i = 0; i < batch.num_ops; i++) {
+		if (YDB_OK != load_atomic_op(PySequence_Fast_GET_ITEM(seq, i), i, &batch.ops[i])) {
+			free_atomic_ops(batch.ops, i);
+			DECREF_AND_RETURN(seq, NULL);
+		}
+	}
+	Py_DECREF(seq);
+	if (Py_None != varnames_py) {
+		namecount = PySequence_Length(varnames_py);
+	}
+	if (0 < namecount) {
+		varnames_ydb = (ydb_buffer_t *)malloc(namecount * sizeof(ydb_buffer_t));
+		if (NULL == varnames_ydb) {
+			free_atomic_ops(batch.ops, batch.num_ops);
+			return PyErr_NoMemory();
+		}
+		/* The buffer array is freed by convert_py_sequence_to_ydb_buffer_array() on failure */
+		if (YDB_OK != convert_py_sequence_to_ydb_buffer_array(varnames_py, namecount, varnames_ydb)) {
+			free_atomic_ops(batch.ops, batch.num_ops);
+			return NULL;
+		}
+	} else {
+		varnames_ydb = NULL;
+	}
+
+	/* Call the wrapped function. The callback does not use the interpreter, so release the GIL for the transaction. */
+	Py_BEGIN_ALLOW_THREADS;
+	status = ydb_tp_s(atomic_callback, &batch, transid, namecount, varnames_ydb);
+	Py_END_ALLOW_THREADS;
+	FREE_BUFFER_ARRAY(varnames_ydb, namecount);
+	if ((YDB_TP_ROLLBACK == status) && (0 <= batch.mismatch)) {
+		free_atomic_ops(batch.ops, batch.num_ops);
+		Py_INCREF(Py_None);
+		return Py_None;
+	} else if (YDB_OK != status) {
+		free_atomic_ops(batch.ops, batch.num_ops);
+		raise_YDBError(status);
+		return NULL;
+	}
+
+	/* Create the list of results */
+	ret = PyList_New(batch.num_ops); // New Reference
+	if (NULL == ret) {
+		free_atomic_ops(batch.ops, batch.num_ops);
+		return NULL;
+	}
+	for (i = 0; (NULL != ret) && (i < batch.num_ops); i++) {
+		op = &batch.ops[i];
+		switch (op->type) {
+		case YDBPython_AtomicGet:
+			if (op->has_result) {
+				result = PyBytes_FromStringAndSize(op->result.buf_addr, (Py_ssize_t)op->result.len_used);
+			} else {
+				Py_INCREF(Py_None);
+				result = Py_None;
+			}
+			break;
+		case YDBPython_AtomicIncr:
+			result = PyBytes_FromStringAndSize(op->result.buf_addr, (Py_ssize_t)op->result.len_used);
+			break;
+		case YDBPython_AtomicData:
+			result = Py_BuildValue("I", op->data);
+			break;
+		default:
+			Py_INCREF(Py_None);
+			result = Py_None;
+			break;
+		}
+		if (NULL == result) {
+			Py_CLEAR(ret);
+		} else {
+			PyList_SET_ITEM(ret, i, result); // Steals the reference to result
+		}
+	}
+	free_atomic_ops(batch.ops, batch.num_ops);
+	return ret;
+}
+
+/* Traverse the subtree of the node specified by `subsarray` in depth-first order, starting after the node `cursor` or at
+ * the root of the subtree if `cursor` is None, and return a list of (subscripts, value) tuples for at most `count` nodes
+ * with a value (or all of them if `count` is 0). If `max_depth` is not negative, nodes more than `max_depth` levels below
+ * the root of the subtree are not included, and the traversal skips past their subtrees rather than visiting them.
+ * If `relative` is set, the subscripts returned omit the subscripts of the root of the subtree. If `decode` is given, the
+ * values are decoded into str objects with it, while the subscripts are returned as bytes objects for use as `cursor`.
+ */
+static PyObject *walk(PyObject *self, PyObject *args, PyObject *kwds) {
+	int	      count, found, max_depth, node_used, next_used, relative, status, subs_used, depth, i;
+	unsigned int  data_value;
+	bool	      candidate, done;
+	PyObject *    varname_py, *subsarray_py, *cursor_py;
+	PyObject *    node_py, *value_py, *item, *ret;
+	const char *  encoding, *errors;
+	ydb_buffer_t  varname_ydb, ret_value;
+	ydb_buffer_t *subsarray_ydb, *cursor_ydb, *node, *next, *swap;
+
+	UNUSED(self);
+	subs_used = 0;	      // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	subsarray_ydb = NULL; // Initialize to prevent "maybe-uninitialized" compiler warning on old versions of GCC
+	/* Default values for optional arguments passed from Python */
+	subsarray_py = Py_None;
+	cursor_py = Py_None;
+	count = 0;
+	max_depth = -1;
+	relative = FALSE;
+	encoding = NULL;
+	errors = "strict";
+
+	/* Parse and validate */
+	static char *kwlist[] = {"varname", "subsarray", "cursor", "count", "max_depth", "relative", "decode", "errors", NULL};
+	/* Parsed values are borrowed references, do not Py_DECREF them. */
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOiipzs", kwlist, &varname_py, &subsarray_py, &cursor_py, &count,
+					 &max_depth, &relative, &encoding, &errors))
+		return NULL;
+	RETURN_IF_INVALID_SEQUENCE(subsarray_py, YDBPython_SubsarraySequence);
+	RETURN_IF_INVALID_SEQUENCE(cursor_py, YDBPython_SubsarraySequence);
+	if (0 > count) {
+		PyErr_SetString(PyExc_ValueError, "'count' must be a non-negative int");
+		return NULL;
+	}
+
+	/* Setup for call */
+	INVOKE_ANYSTR_TO_BUFFER(varname_py, varname_ydb, TRUE);
+	INVOKE_POPULATE_SUBS_USED_AND_SUBSARRAY_AND_CLEANUP_VARNAME(subsarray_py, subs_used, subsarray_ydb, varname_ydb);
+	cursor_ydb = NULL;
+	node_used = subs_used;
+	if (Py_None != cursor_py) {
+		if (YDB_OK != populate_subs_used_and_subsarray(cursor_py, &node_used, &cursor_ydb)) {
+			FREE_BUFFER_ARRAY(subsarray_ydb, subs_used);
+			YDB_FREE_BUFFER(&varname_ydb);
+			return NULL;
+		}
+	}
+	/* Use two arrays with room for the maximum number of subscripts, for the current node and the node returned by
+	 * ydb_node_next_s(), and swap them after each call to avoid copying subscripts.
+	 */
+	node = create_empty_buffer_array(YDB_MAX_SUBS, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+	next = create_empty_buffer_array(YDB_MAX_SUBS, YDBPY_DEFAULT_SUBSCRIPT_LEN);
+	for (i = 0; i < node_used; i++)
+		copy_buffer(&node[i], (NULL == cursor_ydb) ? &subsarray_ydb[i] : &cursor_ydb[i]);
+	FREE_BUFFER_ARRAY(cursor_ydb, node_used);
+	YDB_MALLOC_BUFFER(&ret_value, YDBPY_DEFAULT_VALUE_LEN);
+
+	/* Call the wrapped functions until the traversal leaves the subtree */
+	ret = PyList_New(0); // New Reference
+	found = 0;
+	status = YDB_OK;
+	/* The root of the subtree is only included if the traversal starts there */
+	candidate = (Py_None == cursor_py);
+	done = (NULL == ret);
+	while (!done && (YDB_OK == status)) {
+		if (!candidate) {
+			next_used = YDB_MAX_SUBS;
+			status = ydb_node_next_s(&varname_ydb, node_used, node, &next_used, next);
+			/* If a buffer is not long enough */
+			while (YDB_ERR_INVSTRLEN == status) {
+				FIX_BUFFER_LENGTH(next[next_used]);
+				next_used = YDB_MAX_SUBS;
+				status = ydb_node_next_s(&varname_ydb, node_used, node, &next_used, next);
+			}
+			if (YDB_OK != status)
+				break;
+			swap = node;
+			node = next;
+			next = swap;
+			node_used = next_used;
+		}
+		if ((node_used < subs_used) || (0 != collate_subsarrays(node, subs_used, subsarray_ydb, subs_used)))
+			break;
+		depth = node_used - subs_used;
+		if ((0 <= max_depth) && (max_depth < depth)) {
+			/* Skip past the subtree of the ancestor at `max_depth` by moving to the next subscript at that level, or at
+			 * the level above if there are no more subscripts at that level, until the root of the subtree is reached.
+			 */
+			node_used = subs_used + max_depth;
+			status = YDB_ERR_NODEEND;
+			while ((subs_used < node_used) && (YDB_ERR_NODEEND == status)) {
+				status = subscript_next_or_previous(&varname_ydb, node_used, node, &ret_value, FALSE);
+				if (YDB_OK == status)
+					copy_buffer(&node[node_used - 1], &ret_value);
+				else if (YDB_ERR_NODEEND == status)
+					node_used--;
+			}
+			if (YDB_OK != status)
+				break;
+			/* The next subscript may not have a value itself, in which case the traversal continues with its subtree */
+			status = ydb_data_s(&varname_ydb, node_used, node, &data_value);
+			if (YDB_OK == status)
+				candidate = (YDB_DATA_VALUE_NODESC == data_value) || (YDB_DATA_VALUE_DESC == data_value);
+			continue;
+		}
+		candidate = FALSE;
+		status = ydb_get_s(&varname_ydb, node_used, node, &ret_value);
+		/* Check to see if length of string was longer than the value buffer. If so, try again
+		 * with proper length */
+		if (YDB_ERR_INVSTRLEN == status) {
+			FIX_BUFFER_LENGTH(ret_value);
+			status = ydb_get_s(&varname_ydb, node_used, node, &ret_value);
+			assert(YDB_ERR_INVSTRLEN != status);
+		}
+		if ((YDB_ERR_GVUNDEF == status) || (YDB_ERR_LVUNDEF == status)) {
+			/* The root of the subtree has no value, or the node was deleted, e.g. by another process */
+			status = YDB_OK;
+			continue;
+		} else if (YDB_OK != status)
+			break;
+		if (relative)
+			node_py = convert_ydb_buffer_array_to_py_tuple(&node[subs_used], depth); // New Reference
+		else
+			node_py = convert_ydb_buffer_array_to_py_tuple(node, node_used); // New Reference
+		value_py = (NULL == node_py) ? NULL : new_object_from_buffer(&ret_value, encoding, errors); // New Reference
+		if (NULL == value_py) {
+			Py_XDECREF(node_py);
+			Py_CLEAR(ret);
+			break;
+		}
+		/* Steal the references to node_py and value_py */
+		item = Py_BuildValue("(NN)", node_py, value_py);
+		if ((NULL == item) || (0 != PyList_Append(ret, item))) {
+			Py_XDECREF(item);
+			Py_CLEAR(ret);
+			break;
+		}
+		Py_DECREF(item);
+		found++;
+		done = (found == count);
+	}
+	FREE_BUFFER_ARRAY(subsarray_ydb, subs_used);
+	FREE_BUFFER_ARRAY(node, YDB_MAX_SUBS);
+	FREE_BUFFER_ARRAY(next, YDB_MAX_SUBS);
+	YDB_FREE_BUFFER(&varname_ydb);
+	YDB_FREE_BUFFER(&ret_value);
+
+	if ((YDB_OK != status) && (YDB_ERR_NODEEND != status)) {
+		Py_XDECREF(ret);
+		raise_YDBError(status);
+		return NULL;
+	}
+	return ret;
+}
+
 /* Wrapper for ydb_zwr2str_s() */
 static PyObject *zwr2str(PyObject *self, PyObject *args, PyObject *kwds) {
 	int	     status;
@@ -2291,7 +5472,6 @@ static PyObject *zwr2str(PyObject *self, PyObject *args, PyObject *kwds) {
 /*Comprehensive API
  *Utility Functions
  *
- *    ydb_child_init()
  *    ydb_exit()
  *    ydb_file_id_free() / ydb_file_id_free_t()
  *    ydb_file_is_identical() / ydb_file_is_identical_t()
@@ -2311,6 +5491,52 @@ static PyObject *zwr2str(PyObject *self, PyObject *args, PyObject *kwds) {
  *Calling M Routines
  */
 
+/* Define the wrappers that serialize the module functions */
+DEFINE_SERIALIZED(aggregate)
+DEFINE_SERIALIZED(atomic)
+DEFINE_SERIALIZED(ci)
+DEFINE_SERIALIZED(cip)
+DEFINE_SERIALIZED(data)
+DEFINE_SERIALIZED(delete_wrapper)
+DEFINE_SERIALIZED(delete_except)
+DEFINE_SERIALIZED(diff)
+DEFINE_SERIALIZED(fetch)
+DEFINE_SERIALIZED(get)
+DEFINE_SERIALIZED(get_float)
+DEFINE_SERIALIZED(get_int)
+DEFINE_SERIALIZED(incr)
+DEFINE_SERIALIZED(incr_int)
+DEFINE_SERIALIZED(items)
+DEFINE_SERIALIZED(lock)
+DEFINE_SERIALIZED(lock_decr)
+DEFINE_SERIALIZED(lock_incr)
+DEFINE_SERIALIZED(merge)
+DEFINE_SERIALIZED(message)
+DEFINE_SERIALIZED(merged_nodes)
+DEFINE_SERIALIZED(node_next)
+DEFINE_SERIALIZED(node_previous)
+DEFINE_SERIALIZED(node_scan)
+DEFINE_SERIALIZED(open_ci_table)
+DEFINE_SERIALIZED_NOARGS(release)
+DEFINE_SERIALIZED_NOARGS(adjust_stdout_stderr)
+DEFINE_SERIALIZED(set)
+DEFINE_SERIALIZED(str2zwr)
+DEFINE_SERIALIZED(subscript_count)
+DEFINE_SERIALIZED(subscript_next)
+DEFINE_SERIALIZED(subscript_previous)
+DEFINE_SERIALIZED(subscript_scan)
+DEFINE_SERIALIZED(subtree_stats)
+DEFINE_SERIALIZED(switch_ci_table)
+DEFINE_SERIALIZED(template)
+DEFINE_SERIALIZED(template_get)
+DEFINE_SERIALIZED(template_incr)
+DEFINE_SERIALIZED(template_set)
+DEFINE_SERIALIZED(tp)
+DEFINE_SERIALIZED(utf8_cache_stats)
+DEFINE_SERIALIZED(walk)
+DEFINE_SERIALIZED_NOARGS(zstatus)
+DEFINE_SERIALIZED(zwr2str)
+
 /* Pull everything together into a Python Module */
 /* First we will create an array of structs that represent the methods in the module.
  * (https://docs.python.org/3/c-api/structures.html#c.PyMethodDef)
@@ -2323,107 +5549,162 @@ static PyObject *zwr2str(PyObject *self, PyObject *args, PyObject *kwds) {
  */
 static PyMethodDef methods[] = {
     /* Simple and Simple API Functions */
-    {"ci", (PyCFunction)ci, METH_VARARGS | METH_KEYWORDS,
+    {"aggregate", (PyCFunction)SERIALIZED(aggregate), METH_VARARGS | METH_KEYWORDS,
+     "returns the count, sum, minimum, and maximum of the numeric values in a subtree, optionally grouped by a subscript"},
+    {"atomic", (PyCFunction)SERIALIZED(atomic), METH_VARARGS | METH_KEYWORDS,
+     "executes a sequence of get, set, incr, delete, data and compare-and-set operations in a single transaction"},
+    {"ci", (PyCFunction)SERIALIZED(ci), METH_VARARGS | METH_KEYWORDS,
      "call an M routine defined in the call-in table specified by either the ydb_ci environment variable\n"
      "or switch_ci_table() using the arguments passed, if any"},
-    {"cip", (PyCFunction)cip, METH_VARARGS | METH_KEYWORDS,
+    {"cip", (PyCFunction)SERIALIZED(cip), METH_VARARGS | METH_KEYWORDS,
      "call an M routine defined in the call-in table specified by the ydb_ci environment variable\n"
      "or switch_ci_table() using the arguments passed, if any, while using cached call-in\n"
      "information for performance"},
-    {"data", (PyCFunction)data, METH_VARARGS | METH_KEYWORDS,
+    {"data", (PyCFunction)SERIALIZED(data), METH_VARARGS | METH_KEYWORDS,
      "used to learn what type of data is at a node.\n "
      "0 : There is neither a value nor a subtree, "
      "i.e., it is undefined.\n"
      "1 : There is a value, but no subtree\n"
      "10 : There is no value, but there is a subtree.\n"
      "11 : There are both a value and a subtree.\n"},
-    {"delete", (PyCFunction)delete_wrapper, METH_VARARGS | METH_KEYWORDS, "deletes node value or tree data at node"},
-    {"delete_except", (PyCFunction)delete_except, METH_VARARGS | METH_KEYWORDS,
+    {"delete", (PyCFunction)SERIALIZED(delete_wrapper), METH_VARARGS | METH_KEYWORDS, "deletes node value or tree data at node"},
+    {"delete_except", (PyCFunction)SERIALIZED(delete_except), METH_VARARGS | METH_KEYWORDS,
      "delete the trees of all local variables "
      "except those in the 'varnames' array"},
-    {"get", (PyCFunction)get, METH_VARARGS | METH_KEYWORDS, "returns the value of a node or raises exception"},
-    {"incr", (PyCFunction)incr, METH_VARARGS | METH_KEYWORDS, "increments value by the value specified by 'increment'"},
-
-    {"lock", (PyCFunction)lock, METH_VARARGS | METH_KEYWORDS, "..."},
-
-    {"lock_decr", (PyCFunction)lock_decr, METH_VARARGS | METH_KEYWORDS,
+    {"diff", (PyCFunction)SERIALIZED(diff), METH_VARARGS | METH_KEYWORDS,
+     "returns a list of the nodes added, removed, or changed between the subtrees of two nodes, compared in collation order"},
+    {"fetch", (PyCFunction)SERIALIZED(fetch), METH_VARARGS | METH_KEYWORDS,
+     "returns a tuple of the data status of a node and its value, or None if the node has no value"},
+    {"get", (PyCFunction)SERIALIZED(get), METH_VARARGS | METH_KEYWORDS, "returns the value of a node or raises exception"},
+    {"get_float", (PyCFunction)SERIALIZED(get_float), METH_VARARGS | METH_KEYWORDS,
+     "returns the value of a node as a float, None if the node has no value, or raises ValueError if the value is not numeric"},
+    {"get_int", (PyCFunction)SERIALIZED(get_int), METH_VARARGS | METH_KEYWORDS,
+     "returns the value of a node as an int, None if the node has no value, or raises ValueError if the value is not an integer"},
+    {"incr", (PyCFunction)SERIALIZED(incr), METH_VARARGS | METH_KEYWORDS, "increments value by the value specified by 'increment'"},
+    {"incr_int", (PyCFunction)SERIALIZED(incr_int), METH_VARARGS | METH_KEYWORDS,
+     "increments value by the int specified by 'increment' and returns the new value as a number"},
+
+    {"items", (PyCFunction)SERIALIZED(items), METH_VARARGS | METH_KEYWORDS,
+     "returns a list of (subscript, value) tuples for the subscripts that follow a subscript at the same level"},
+    {"lock", (PyCFunction)SERIALIZED(lock), METH_VARARGS | METH_KEYWORDS, "..."},
+
+    {"lock_decr", (PyCFunction)SERIALIZED(lock_decr), METH_VARARGS | METH_KEYWORDS,
      "Decrements the count of the specified lock held "
      "by the process. As noted in the Concepts section, a "
      "lock whose count goes from 1 to 0 is released. A lock "
      "whose name is specified, but which the process does "
      "not hold, is ignored."},
-    {"lock_incr", (PyCFunction)lock_incr, METH_VARARGS | METH_KEYWORDS,
+    {"lock_incr", (PyCFunction)SERIALIZED(lock_incr), METH_VARARGS | METH_KEYWORDS,
      "Without releasing any locks held by the process, "
      "attempt to acquire the requested lock incrementing it"
      " if already held."},
-    {"message", (PyCFunction)message, METH_VARARGS | METH_KEYWORDS,
+    {"merge", (PyCFunction)SERIALIZED(merge), METH_VARARGS | METH_KEYWORDS,
+     "copies the subtree of a node to another node, as with the M MERGE command"},
+    {"message", (PyCFunction)SERIALIZED(message), METH_VARARGS | METH_KEYWORDS,
      "return the message string corresponding to the specified error code number\n"},
-    {"node_next", (PyCFunction)node_next, METH_VARARGS | METH_KEYWORDS,
+    {"merged_nodes", (PyCFunction)SERIALIZED(merged_nodes), METH_VARARGS | METH_KEYWORDS,
+     "returns a list of the nodes with a value in the subtrees of several nodes, merged into a single collation order"},
+    {"node_next", (PyCFunction)SERIALIZED(node_next), METH_VARARGS | METH_KEYWORDS,
      "facilitate depth-first traversal of a local or global"
      " variable tree. returns string tuple of subscripts of"
-     " next node with value."},
-    {"node_previous", (PyCFunction)node_previous, METH_VARARGS | METH_KEYWORDS,
+     " next node with value. returns default, if given, instead"
+     " of raising YDBNodeEnd when there is no next node."},
+    {"node_previous", (PyCFunction)SERIALIZED(node_previous), METH_VARARGS | METH_KEYWORDS,
      "facilitate depth-first traversal of a local "
      "or global variable tree. returns string tuple"
-     "of subscripts of previous node with value."},
-    {"open_ci_table", (PyCFunction)open_ci_table, METH_VARARGS | METH_KEYWORDS,
+     "of subscripts of previous node with value. returns default,"
+     " if given, instead of raising YDBNodeEnd when there is no previous node."},
+    {"node_scan", (PyCFunction)SERIALIZED(node_scan), METH_VARARGS | METH_KEYWORDS,
+     "returns a list of the subscripts of the nodes with values that follow (or precede) a node,"
+     " within optional start, stop and prefix boundaries"},
+    {"open_ci_table", (PyCFunction)SERIALIZED(open_ci_table), METH_VARARGS | METH_KEYWORDS,
      "open the specified call-in table file to allow calls to functions specified therein using ci() and cip()\n"},
-    {"release", (PyCFunction)release, METH_NOARGS,
+    {"release", (PyCFunction)SERIALIZED(release), METH_NOARGS,
      "returns the release number of the active YottaDB installation. Equivalent to $ZYRELEASE in M.\n"},
-    {"adjust_stdout_stderr", (PyCFunction)adjust_stdout_stderr, METH_NOARGS,
+    {"adjust_stdout_stderr", (PyCFunction)SERIALIZED(adjust_stdout_stderr), METH_NOARGS,
      "Check whether stdout (file descriptor 1) and stderr (file descriptor 2) are the same file, and if so, route stderr writes to "
      "stdout instead.\n"},
-    {"set", (PyCFunction)set, METH_VARARGS | METH_KEYWORDS, "sets the value of a node or raises exception"},
-    {"str2zwr", (PyCFunction)str2zwr, METH_VARARGS | METH_KEYWORDS,
+    {"child_init", (PyCFunction)child_init, METH_NOARGS,
+     "reinitialize YottaDB in a child process created by fork(), before the child process uses YottaDB\n"},
+    {"set", (PyCFunction)SERIALIZED(set), METH_VARARGS | METH_KEYWORDS, "sets the value of a node or raises exception"},
+    {"str2zwr", (PyCFunction)SERIALIZED(str2zwr), METH_VARARGS | METH_KEYWORDS,
      "returns the zwrite formatted (Bytes Object) version of the"
      " Bytes object provided as input."},
-    {"subscript_next", (PyCFunction)subscript_next, METH_VARARGS | METH_KEYWORDS,
+    {"subscript_count", (PyCFunction)SERIALIZED(subscript_count), METH_VARARGS | METH_KEYWORDS,
+     "returns the number of child subscripts of a node"},
+    {"subscript_next", (PyCFunction)SERIALIZED(subscript_next), METH_VARARGS | METH_KEYWORDS,
      "returns the name of the next subscript at "
-     "the same level as the one given"},
-    {"subscript_previous", (PyCFunction)subscript_previous, METH_VARARGS | METH_KEYWORDS,
+     "the same level as the one given. returns default, if given,"
+     " instead of raising YDBNodeEnd when there is no next subscript."},
+    {"subscript_previous", (PyCFunction)SERIALIZED(subscript_previous), METH_VARARGS | METH_KEYWORDS,
      "returns the name of the previous "
      "subscript at the same level as the "
-     "one given"},
-    {"switch_ci_table", (PyCFunction)switch_ci_table, METH_VARARGS | METH_KEYWORDS,
+     "one given. returns default, if given, instead of raising"
+     " YDBNodeEnd when there is no previous subscript."},
+    {"subscript_scan", (PyCFunction)SERIALIZED(subscript_scan), METH_VARARGS | METH_KEYWORDS,
+     "returns a list of the subscripts that follow (or precede) a subscript at the same level,"
+     " within optional start, stop and prefix boundaries"},
+    {"subtree_stats", (PyCFunction)SERIALIZED(subtree_stats), METH_VARARGS | METH_KEYWORDS,
+     "returns the number of nodes, total value size, maximum depth, and value size and fan-out histograms of a subtree"},
+    {"switch_ci_table", (PyCFunction)SERIALIZED(switch_ci_table), METH_VARARGS | METH_KEYWORDS,
      "switch to the call-in table referenced by the integer held in the passed handle\n"
      "and return the value of the previous handle"},
-    {"tp", (PyCFunction)tp, METH_VARARGS | METH_KEYWORDS, "transaction"},
-
-    {"zwr2str", (PyCFunction)zwr2str, METH_VARARGS | METH_KEYWORDS,
+    {"template", (PyCFunction)SERIALIZED(template), METH_VARARGS | METH_KEYWORDS,
+     "returns a prepared node, of which None subscripts are placeholders, for use with template_get(), template_set() and"
+     " template_incr()"},
+    {"template_get", (PyCFunction)SERIALIZED(template_get), METH_VARARGS | METH_KEYWORDS,
+     "returns the value of the node of a template with the given placeholder subscripts, or None if it has no value"},
+    {"template_incr", (PyCFunction)SERIALIZED(template_incr), METH_VARARGS | METH_KEYWORDS,
+     "increments the value of the node of a template with the given placeholder subscripts and returns the new value"},
+    {"template_set", (PyCFunction)SERIALIZED(template_set), METH_VARARGS | METH_KEYWORDS,
+     "sets the value of the node of a template with the given placeholder subscripts"},
+    {"tp", (PyCFunction)SERIALIZED(tp), METH_VARARGS | METH_KEYWORDS, "transaction"},
+    {"utf8_cache_stats", (PyCFunction)SERIALIZED(utf8_cache_stats), METH_VARARGS | METH_KEYWORDS,
+     "returns the number of ASCII (hits) and other (potential misses) str objects converted to buffers,"
+     " and resets the counts if reset is True"},
+
+    {"walk", (PyCFunction)SERIALIZED(walk), METH_VARARGS | METH_KEYWORDS,
+     "returns a list of (subscripts, value) tuples for the nodes with values in a subtree, in depth-first order"},
+    {"zstatus", (PyCFunction)SERIALIZED(zstatus), METH_NOARGS,
+     "returns the value of $ZSTATUS, i.e. the message text of the most recent YottaDB error\n"},
+    {"zwr2str", (PyCFunction)SERIALIZED(zwr2str), METH_VARARGS | METH_KEYWORDS,
      "returns the Bytes Object from the zwrite formated Bytes "
      "object provided as input."},
     /* API Utility Functions */
     {NULL, NULL, 0, NULL} /* Sentinel */
 };
 
-/* The _yottadbmodule struct contains the information about the Python module per:
- * https://docs.python.org/3/c-api/module.html#initializing-c-modules
- *
- * A number of PyModuleDef struct members are unused by YDBPython, and so are
- * set to NULL to prevent compiler warnings.
- *
- * For a full list of PyModuleDef struct members, see:
- * https://docs.python.org/3/c-api/module.html#c.PyModuleDef
+/* Create an exception, named in 'module.classname' form, with the given base class (NULL if base class is Pythons base
+ * Exception class), store it in the module state, and add it to the module. See:
+ *	https://docs.python.org/3/c-api/exceptions.html#c.PyErr_NewException
+ *	https://docs.python.org/3/c-api/module.html#c.PyModule_AddObject
  */
-static struct PyModuleDef _yottadbmodule = {PyModuleDef_HEAD_INIT,
-					    "_yottadb",
-					    "A module that provides basic access to the YottaDB's Simple API",
-					    -1,
-					    methods,
-					    NULL,
-					    NULL,
-					    NULL,
-					    NULL};
+static int add_exception(PyObject *module, PyObject **exception, char *name, PyObject *base) {
+	*exception = PyErr_NewException(name, base, NULL);
+	if (NULL == *exception) {
+		return -1;
+	}
+	// PyModule_AddObject steals a reference on success, and the module state keeps another
+	Py_INCREF(*exception);
+	if (0 > PyModule_AddObject(module, strchr(name, '.') + 1, *exception)) {
+		Py_DECREF(*exception);
+		return -1;
+	}
+	return 0;
+}
 
-/* The initialization function for _yottadb.
- * This function must be named PyInit_{name of Module}
+/* The execution slot of the _yottadb module, which initializes a new module object and its state. It is run once for
+ * each interpreter that imports the module.
  */
-PyMODINIT_FUNC PyInit__yottadb(void) {
-	/* Initialize the module */
-	PyObject *module = PyModule_Create(&_yottadbmodule);
+static int exec_module(PyObject *module) {
+	YDBPyModuleState *state;
+	PyObject *	  module_dictionary;
+
+	/* api_lock is shared by all interpreters, so it is only initialized by the first one */
+	pthread_once(&api_lock_once, init_api_lock);
 
 	/* Defining Module 'Constants' */
-	PyObject *module_dictionary = PyModule_GetDict(module);
+	module_dictionary = PyModule_GetDict(module);
 
 	/* Expose constants defined in libyottadb.h */
 	ADD_YDBCONSTANTS(module_dictionary)
@@ -2435,26 +5716,13 @@ PyMODINIT_FUNC PyInit__yottadb(void) {
 	PyDict_SetItemString(module_dictionary, "YDB_LOCK_MAX_NODES", Py_BuildValue("i", YDB_LOCK_MAX_NODES));
 
 	/* Adding Exceptions */
-	/* Step 1: create exception with PyErr_NewException.
-		Arguments: (https://docs.python.org/3/c-api/exceptions.html#c.PyErr_NewException)
-	 *              1. Name of the exception in 'module.classname' form
-	 *              2. The Base class of the exception (NULL if base class is Pythons base Exception class
-	 *              3. A dictionary of class variables and methods. (Usually NULL)
-	 * Step 2: Add this Exception to the module using PyModule_AddObject
-		(https://docs.python.org/3/c-api/module.html#c.PyModule_AddObject)
-	 */
-	YDBException = PyErr_NewException("_yottadb.YDBException", NULL, NULL);
-	PyModule_AddObject(module, "YDBException", YDBException);
-
-	YDBTPException = PyErr_NewException("_yottadb.YDBTPException", YDBException, NULL);
-	PyModule_AddObject(module, "YDBTPException", YDBTPException);
-
-	YDBPythonError = PyErr_NewException("_yottadb.YDBPythonError", YDBException, NULL);
-	PyModule_AddObject(module, "YDBPythonError", YDBPythonError);
-
-	YDBError = PyErr_NewException("_yottadb.YDBError", YDBException, NULL);
-	PyModule_AddObject(module, "YDBError", YDBError);
-
+	state = PyModule_GetState(module);
+	if ((0 > add_exception(module, &state->YDBException, "_yottadb.YDBException", NULL))
+	    || (0 > add_exception(module, &state->YDBTPException, "_yottadb.YDBTPException", state->YDBException))
+	    || (0 > add_exception(module, &state->YDBPythonError, "_yottadb.YDBPythonError", state->YDBException))
+	    || (0 > add_exception(module, &state->YDBError, "_yottadb.YDBError", state->YDBException))) {
+		return -1;
+	}
 	/* Below are custom exceptions to be raised when a YottaDB API function
 	 * returns a status that must be propagated to the Python-level user, but
 	 * is not, strictly speaking an error. These exceptions thus omit "Error"
@@ -2462,27 +5730,100 @@ PyMODINIT_FUNC PyInit__yottadb(void) {
 	 * YDB_ERR_NODEEND, is derived from sr_unix/libyottadb.h in the YottaDB
 	 * source code.
 	 */
-	YDBTPRollback = PyErr_NewException("_yottadb.YDBTPRollback", YDBTPException, NULL);
-	PyModule_AddObject(module, "YDBTPRollback", YDBTPRollback);
+	if ((0 > add_exception(module, &state->YDBTPRollback, "_yottadb.YDBTPRollback", state->YDBTPException))
+	    || (0 > add_exception(module, &state->YDBTPRestart, "_yottadb.YDBTPRestart", state->YDBTPException))
+	    || (0 > add_exception(module, &state->YDBNotOk, "_yottadb.YDBNotOk", state->YDBException))
+	    || (0 > add_exception(module, &state->YDBLockTimeoutError, "_yottadb.YDBLockTimeoutError", state->YDBException))
+	    || (0 > add_exception(module, &state->YDBTPTimeoutError, "_yottadb.YDBTPTimeoutError", state->YDBException))
+	    || (0 > add_exception(module, &state->YDBDeferHandler, "_yottadb.YDBDeferHandler", state->YDBException))
+	    || (0 > add_exception(module, &state->YDBNodeEnd, "_yottadb.YDBNodeEnd", state->YDBException))) {
+		return -1;
+	}
+	return 0;
+}
 
-	YDBTPRestart = PyErr_NewException("_yottadb.YDBTPRestart", YDBTPException, NULL);
-	PyModule_AddObject(module, "YDBTPRestart", YDBTPRestart);
+/* Visit the references held by the state of a _yottadb module object for the garbage collector */
+static int traverse_module(PyObject *module, visitproc visit, void *arg) {
+	YDBPyModuleState *state;
+
+	state = PyModule_GetState(module);
+	Py_VISIT(state->YDBException);
+	Py_VISIT(state->YDBError);
+	Py_VISIT(state->YDBTPException);
+	Py_VISIT(state->YDBTPRestart);
+	Py_VISIT(state->YDBTPRollback);
+	Py_VISIT(state->YDBNotOk);
+	Py_VISIT(state->YDBDeferHandler);
+	Py_VISIT(state->YDBNodeEnd);
+	Py_VISIT(state->YDBLockTimeoutError);
+	Py_VISIT(state->YDBTPTimeoutError);
+	Py_VISIT(state->YDBPythonError);
+	return 0;
+}
 
-	YDBNotOk = PyErr_NewException("_yottadb.YDBNotOk", YDBException, NULL);
-	PyModule_AddObject(module, "YDBNotOk", YDBNotOk);
+/* Release the references held by the state of a _yottadb module object */
+static int clear_module(PyObject *module) {
+	YDBPyModuleState *state;
+
+	state = PyModule_GetState(module);
+	Py_CLEAR(state->YDBException);
+	Py_CLEAR(state->YDBError);
+	Py_CLEAR(state->YDBTPException);
+	Py_CLEAR(state->YDBTPRestart);
+	Py_CLEAR(state->YDBTPRollback);
+	Py_CLEAR(state->YDBNotOk);
+	Py_CLEAR(state->YDBDeferHandler);
+	Py_CLEAR(state->YDBNodeEnd);
+	Py_CLEAR(state->YDBLockTimeoutError);
+	Py_CLEAR(state->YDBTPTimeoutError);
+	Py_CLEAR(state->YDBPythonError);
+	return 0;
+}
 
-	YDBLockTimeoutError = PyErr_NewException("_yottadb.YDBLockTimeoutError", YDBException, NULL);
-	PyModule_AddObject(module, "YDBLockTimeoutError", YDBLockTimeoutError);
+/* Free the state of a _yottadb module object when the interpreter that imported it is finalized */
+static void free_module(void *module) {
+	YDBPyModuleState *state;
 
-	YDBTPTimeoutError = PyErr_NewException("_yottadb.YDBTPTimeoutError", YDBException, NULL);
-	PyModule_AddObject(module, "YDBTPTimeoutError", YDBTPTimeoutError);
+	clear_module((PyObject *)module);
+	state = PyModule_GetState((PyObject *)module);
+	free_ci_name_descriptor(&state->ci_info);
+}
 
-	YDBDeferHandler = PyErr_NewException("_yottadb.YDBDeferHandler", YDBException, NULL);
-	PyModule_AddObject(module, "YDBDeferHandler", YDBDeferHandler);
+/* The slots of the _yottadb module for multi-phase initialization per:
+ * https://docs.python.org/3/c-api/module.html#multi-phase-initialization
+ *
+ * The module keeps all of its Python objects in its state, so it may be imported by interpreters that have their own
+ * GIL. Its functions remain serialized by api_lock, so the GIL need not be enabled for it in free-threaded builds.
+ */
+static PyModuleDef_Slot slots[] = {{Py_mod_exec, __extension__(void *) exec_module}, // ISO C lacks function to void * casts
+#ifdef Py_mod_multiple_interpreters
+				   {Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
+#endif
+#ifdef Py_mod_gil
+				   {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+#endif
+				   {0, NULL}};
 
-	YDBNodeEnd = PyErr_NewException("_yottadb.YDBNodeEnd", YDBException, NULL);
-	PyModule_AddObject(module, "YDBNodeEnd", YDBNodeEnd);
+/* The _yottadbmodule struct contains the information about the Python module per:
+ * https://docs.python.org/3/c-api/module.html#initializing-c-modules
+ *
+ * For a full list of PyModuleDef struct members, see:
+ * https://docs.python.org/3/c-api/module.html#c.PyModuleDef
+ */
+static struct PyModuleDef _yottadbmodule = {PyModuleDef_HEAD_INIT,
+					    "_yottadb",
+					    "A module that provides basic access to the YottaDB's Simple API",
+					    sizeof(YDBPyModuleState),
+					    methods,
+					    slots,
+					    traverse_module,
+					    clear_module,
+					    free_module};
 
-	/* return the now fully initialized module */
-	return module;
+/* The initialization function for _yottadb.
+ * This function must be named PyInit_{name of Module}
+ */
+PyMODINIT_FUNC PyInit__yottadb(void) {
+	/* Return the module definition, from which the module is created and then initialized by exec_module() */
+	return PyModuleDef_Init(&_yottadbmodule);
 }
@@ -2,7 +2,7 @@
  *                                                              *
  * Copyright (c) 2020-2021 Peter Goss All rights reserved.      *
  *                                                              *
- * Copyright (c) 2020-2025 YottaDB LLC and/or its subsidiaries. *
+ * Copyright (c) 2020-2026 YottaDB LLC and/or its subsidiaries. *
  * All rights reserved.                                         *
  *                                                              *
  *  This source code contains the intellectual property         *
@@ -15,10 +15,24 @@
 #include <libyottadb.h>
 #include <Python.h>
 
+// Vectorcall was provisional in Python 3.8, and its functions only had private names
+#if PY_VERSION_HEX < 0x03090000
+#define PyObject_VectorcallDict _PyObject_FastCallDict
+#endif
+
 #define YDBPY_DEFAULT_VALUE_LEN	       32
 #define YDBPY_DEFAULT_SUBSCRIPT_LEN    16
 #define YDBPY_DEFAULT_SUBSCRIPT_COUNT  2
 #define CANONICAL_NUMBER_TO_STRING_MAX 48
+#define CANONICAL_NUMBER_MAX_DIGITS    18
+#define YDBPY_SCAN_PREFIX_NUMBER_CHARS "-.0123456789"
+
+// YottaDB numbers are less than 1E47 and no smaller than 1E-43 in absolute value
+#define CANONICAL_NUMBER_MAX_INTEGER_DIGITS 47
+#define CANONICAL_NUMBER_MAX_FRACTION_ZEROS 42
+
+// Histogram buckets for 0 and for each power of two up to 2^63, as used by subtree_stats()
+#define YDBPY_HISTOGRAM_BUCKETS 65
 
 #define YDB_LOCK_MIN_ARGS		2
 #define YDB_LOCK_ARGS_PER_NODE		3
@@ -55,6 +69,33 @@ typedef enum YDBPythonSequenceType {
 	YDBPython_NodeSequence,
 } YDBPythonSequenceType;
 
+/* Set of Python numeric types that a YottaDB canonical number may be converted to
+ * by the typed value accessors, e.g. get_int() and get_float().
+ */
+typedef enum YDBPythonNumberType {
+	YDBPython_Integer,
+	YDBPython_Float,
+	YDBPython_IntegerOrFloat,
+} YDBPythonNumberType;
+
+/* Result of checking a subscript or node against the boundaries of a subscript_scan() or node_scan() call */
+typedef enum YDBPythonScanResult {
+	YDBPython_ScanMatch,
+	YDBPython_ScanSkip,
+	YDBPython_ScanEnd,
+} YDBPythonScanResult;
+
+/* Set of operations that may be passed to atomic() */
+typedef enum YDBPythonAtomicOpType {
+	YDBPython_AtomicGet,
+	YDBPython_AtomicSet,
+	YDBPython_AtomicIncr,
+	YDBPython_AtomicDelete,
+	YDBPython_AtomicDeleteTree,
+	YDBPython_AtomicData,
+	YDBPython_AtomicCompareAndSet,
+} YDBPythonAtomicOpType;
+
 // TypeError messages
 #define YDBPY_ERR_IMMUTABLE_OUTPUT_ARGS                                                                                           \
 	"YottaDB call-in argument list is immutable, but routine has output argument(s). Pass argument list as a Python List to " \
@@ -83,16 +124,60 @@ typedef enum YDBPythonSequenceType {
 
 #define YDBPY_ERR_VARNAME_INVALID     "'varnames' argument invalid: %s"
 #define YDBPY_ERR_SUBSARRAY_INVALID   "'subsarray' argument invalid: %s"
+#define YDBPY_ERR_PARAMS_INVALID      "'params' argument invalid: %s"
 #define YDBPY_ERR_NODES_INVALID	      "'nodes' argument invalid: %s"
 #define YDBPY_ERR_ROUTINE_UNSPECIFIED "No call-in routine specified. Routine name required for M call-in."
 
 #define YDBPY_ERR_SYSCALL "System call failed: %s, return %d (%s)"
 
 #define YDBPY_ERR_FAILED_NUMERIC_CONVERSION "Failed to convert Python numeric value to internal representation"
+#define YDBPY_ERR_VALUE_NOT_NUMERIC	    "node value is not a valid %s: '%.*s'"
+#define YDBPY_ERR_VALUE_TOO_LONG_FOR_NUMBER "node value is not a valid %s: length %u exceeds max %d"
+#define YDBPY_ERR_MERGE_DESCENDANT	    "cannot merge a node with its own ancestor or descendant"
+#define YDBPY_ERR_MERGE_SOURCE		    "each source must be a (varname, subsarray) pair"
+#define YDBPY_ERR_TEMPLATE_PARAMS	    "template has %d placeholder subscripts, but %ld params were given"
+#define YDBPY_ERR_OPS_INVALID		    "'ops' argument invalid: %s"
+#define YDBPY_ERR_OP_UNKNOWN		    "item %ld has unknown operation '%s'"
+#define YDBPY_ERR_OP_INCORRECT_LENGTH	    "item %ld must be length %d to %d for operation '%s'"
 
 // Prevents compiler warnings for variables used only in asserts
 #define UNUSED(x) (void)(x)
 
+/* The YottaDB Simple API serves one caller at a time, so each module function is wrapped by a function that holds a
+ * process-wide lock while it runs. The GIL alone is not enough, since another thread may run while a tp() callback runs
+ * Python code, and there is no GIL at all in free-threaded builds of CPython, nor a GIL shared between interpreters that
+ * each have their own. The wrapper also points module_state to the state of the module passed to the function, and
+ * restores the previous state afterward, in case the function was called from a tp() callback.
+ */
+#define SERIALIZED(FUNCTION) FUNCTION##_serialized
+#define DEFINE_SERIALIZED(FUNCTION)                                                              \
+	static PyObject *FUNCTION##_serialized(PyObject *self, PyObject *args, PyObject *kwds) { \
+		PyObject *	  ret;                                                          \
+		YDBPyModuleState *caller_state;                                                 \
+                                                                                                 \
+		acquire_api_lock();                                                             \
+		caller_state = module_state;                                                    \
+		module_state = PyModule_GetState(self);                                         \
+		ret = FUNCTION(self, args, kwds);                                               \
+		module_state = caller_state;                                                    \
+		pthread_mutex_unlock(&api_lock);                                                \
+		return ret;                                                                     \
+	}
+#define DEFINE_SERIALIZED_NOARGS(FUNCTION)                                        \
+	static PyObject *FUNCTION##_serialized(PyObject *self, PyObject *unused) { \
+		PyObject *	  ret;                                           \
+		YDBPyModuleState *caller_state;                                  \
+                                                                                  \
+		UNUSED(unused);                                                   \
+		acquire_api_lock();                                               \
+		caller_state = module_state;                                      \
+		module_state = PyModule_GetState(self);                           \
+		ret = FUNCTION(self);                                             \
+		module_state = caller_state;                                      \
+		pthread_mutex_unlock(&api_lock);                                  \
+		return ret;                                                       \
+	}
+
 // Redefine __assert_fail from libc (used by assert.h) to enable custom assert message.
 void __assert_fail(const char *assertion, const char *file, unsigned int line, const char *function) {
 	fprintf(stderr,
@@ -111,6 +196,50 @@ typedef struct {
 	ydb_buffer_t *subsarray;
 } YDBNode;
 
+/* Boundaries of a subscript_scan() call. Omitted boundaries have a NULL buf_addr. */
+typedef struct {
+	ydb_buffer_t start;
+	ydb_buffer_t stop;
+	ydb_buffer_t prefix;
+	bool	     prefix_may_be_number;
+} YDBSubscriptBounds;
+
+/* Boundaries of a node_scan() call. Omitted boundaries have a subs_used of -1. */
+typedef struct {
+	int	      start_used;
+	ydb_buffer_t *start;
+	int	      stop_used;
+	ydb_buffer_t *stop;
+	int	      prefix_used;
+	ydb_buffer_t *prefix;
+} YDBNodeBounds;
+
+/* Running totals of the numeric values of an aggregate() call. The integer totals are used while all values
+ * are integers and their sum fits in a long long.
+ */
+typedef struct {
+	unsigned long long count;
+	bool		   is_integer;
+	long long	   integer_sum;
+	long long	   integer_min;
+	long long	   integer_max;
+	long double	   sum;
+	long double	   min;
+	long double	   max;
+} YDBAggregate;
+
+/* The traversal of one input of a merged_nodes() call, positioned at the next node with a value in its subtree */
+typedef struct {
+	ydb_buffer_t  varname;
+	int	      subs_used;
+	ydb_buffer_t *subsarray;
+	int	      node_used;
+	ydb_buffer_t *node;
+	ydb_buffer_t *next;
+	ydb_buffer_t  value;
+	bool	      in_subtree;
+} YDBMergeSource;
+
 #define YDB_COPY_BYTES_TO_BUFFER(BYTES, BYTES_LEN, BUFFERP, COPY_DONE) \
 	{                                                              \
 		if (BYTES_LEN <= (BUFFERP)->len_alloc) {               \
@@ -207,31 +336,108 @@ typedef struct {
 		}                                                                                                        \
 	}
 
-/* PYTHON EXCEPTION DECLARATIONS */
+/* Name of the PyCapsule objects returned by template() */
+#define YDBPY_TEMPLATE_CAPSULE "_yottadb.template"
 
-/* YottaDBError represents an error return status from any of the libyottadb
- * functions being wrapped. Since YottaDB returns a status that is a number and
- * has a way to create a message from that number the choice was to preserve
- * both in the python exception. This means we need to extend the exception to
- * accept both. Use raise_YottaDBError function to raise
+/* A node of which the variable name and constant subscripts are converted to buffers and validated once by template().
+ * The remaining subscripts are placeholders, whose buffers are pointed to the params passed to template_get(),
+ * template_set() or template_incr() for the duration of each call, without copying them.
  */
-static PyObject *YDBException;
-static PyObject *YDBError;
-
-static PyObject *YDBTPException;
-static PyObject *YDBTPRestart;
-static PyObject *YDBTPRollback;
-static PyObject *YDBNotOk;
-static PyObject *YDBDeferHandler;
-static PyObject *YDBNodeEnd;
-
-/* YDBLockTimeoutError is a simple exception to indicate that a lock failed due
- * to timeout. */
-static PyObject *YDBLockTimeoutError;
-/* YDBTPTimeoutError is a simple exception to indicate that a transaction callback
- * function failed due to timeout. */
-static PyObject *YDBTPTimeoutError;
-
-/* YDBPythonError is to be raised when there is a possibility for an error to
-   occur but that we believe that it should never happen. */
-static PyObject *YDBPythonError;
+typedef struct {
+	ydb_buffer_t varname;
+	int	     subs_used;
+	ydb_buffer_t subsarray[YDB_MAX_SUBS];
+	int	     num_params;
+	int	     params[YDB_MAX_SUBS]; // Indices of the placeholder subscripts in subsarray
+} YDBTemplate;
+
+/* The Python callback of a tp() call and its arguments, which are borrowed from the caller of tp(). `args` is NULL if there
+ * are no positional arguments, and `kwargs` is NULL if there are no keyword arguments, so that the callback may be called
+ * on each attempt of the transaction without allocating any objects.
+ */
+typedef struct {
+	PyObject *callback;
+	PyObject *args;
+	PyObject *kwargs;
+} YDBTPCallback;
+
+/* An operation of an atomic() call, of which all arguments are converted to buffers before the transaction starts, so
+ * that the transaction callback, and each of its restarts, runs without the interpreter.
+ */
+typedef struct {
+	YDBPythonAtomicOpType type;
+	ydb_buffer_t	      varname;
+	int		      subs_used;
+	ydb_buffer_t *	      subsarray;
+	ydb_buffer_t	      value;	 // Value of set, increment of incr, or expected value of compare_and_set
+	bool		      has_value; // FALSE if compare_and_set expects the node to have no value
+	ydb_buffer_t	      new_value; // New value of compare_and_set
+	bool		      has_new_value;
+	ydb_buffer_t	      result; // Value read by get and compare_and_set, or returned by incr
+	bool		      has_result;
+	unsigned int	      data;
+} YDBAtomicOp;
+
+/* The operations of an atomic() call, passed to its transaction callback */
+typedef struct {
+	YDBAtomicOp *ops;
+	int	     num_ops;
+	int	     mismatch; // Index of the compare_and_set operation that rolled back the transaction, or -1
+} YDBAtomicBatch;
+
+/* MODULE STATE */
+
+/* Utility structure for maintaining call-in information
+ * used in ydb_cip calls.
+ *
+ * This struct serves as an anchor point for the C call-in routine descriptor
+ * used by cip() that provides for less call-in overhead than ci() as the descriptor
+ * contains fastpath information filled in by YottaDB after the first call. This allows
+ * subsequent calls to have minimal overhead. Because this structure's contents contain
+ * pointers to C allocated storage, it is not exposed to Python-level users.
+ */
+typedef struct {
+	char *		   routine_name;
+	bool		   has_parm_types;
+	ci_name_descriptor ci_info;
+	ci_parm_type	   parm_types;
+} py_ci_name_descriptor;
+
+/* The state of the _yottadb module, of which each interpreter that imports the module has its own instance, per:
+ * https://docs.python.org/3/howto/isolating-extensions.html
+ */
+typedef struct {
+	/* YottaDBError represents an error return status from any of the libyottadb
+	 * functions being wrapped. Since YottaDB returns a status that is a number and
+	 * has a way to create a message from that number the choice was to preserve
+	 * both in the python exception. This means we need to extend the exception to
+	 * accept both. Use raise_YottaDBError function to raise
+	 */
+	PyObject *YDBException;
+	PyObject *YDBError;
+
+	PyObject *YDBTPException;
+	PyObject *YDBTPRestart;
+	PyObject *YDBTPRollback;
+	PyObject *YDBNotOk;
+	PyObject *YDBDeferHandler;
+	PyObject *YDBNodeEnd;
+
+	/* YDBLockTimeoutError is a simple exception to indicate that a lock failed due
+	 * to timeout. */
+	PyObject *YDBLockTimeoutError;
+	/* YDBTPTimeoutError is a simple exception to indicate that a transaction callback
+	 * function failed due to timeout. */
+	PyObject *YDBTPTimeoutError;
+
+	/* YDBPythonError is to be raised when there is a possibility for an error to
+	   occur but that we believe that it should never happen. */
+	PyObject *YDBPythonError;
+
+	// Call-in information of the most recent routine called by cip()
+	py_ci_name_descriptor ci_info;
+
+	// Number of ASCII and other str objects converted to buffers, reported by utf8_cache_stats()
+	unsigned long long utf8_cache_hits;
+	unsigned long long utf8_cache_misses;
+} YDBPyModuleState;
@@ -2,7 +2,7 @@
 #                                                               #
 # Copyright (c) 2019-2021 Peter Goss All rights reserved.       #
 #                                                               #
-# Copyright (c) 2019-2025 YottaDB LLC and/or its subsidiaries.  #
+# Copyright (c) 2019-2026 YottaDB LLC and/or its subsidiaries.  #
 # All rights reserved.                                          #
 #                                                               #
 #   This source code contains the intellectual property         #
@@ -253,6 +253,21 @@ def test_data(simple_data):
     assert _yottadb.data(b"^test3", (b"sub1", b"sub2")) == _yottadb.YDB_DATA_VALUE_NODESC
 
 
+def test_fetch(simple_data):
+    assert _yottadb.fetch("^nodata") == (_yottadb.YDB_DATA_UNDEF, None)
+    assert _yottadb.fetch("^test1") == (_yottadb.YDB_DATA_VALUE_NODESC, b"test1value")
+    assert _yottadb.fetch("^test2") == (_yottadb.YDB_DATA_NOVALUE_DESC, None)
+    assert _yottadb.fetch("^test2", ("sub1",)) == (_yottadb.YDB_DATA_VALUE_NODESC, b"test2value")
+    assert _yottadb.fetch("^test3") == (_yottadb.YDB_DATA_VALUE_DESC, b"test3value1")
+    assert _yottadb.fetch(varname="^test3", subsarray=("sub1",)) == (_yottadb.YDB_DATA_VALUE_DESC, b"test3value2")
+    # Using bytes arguments
+    assert _yottadb.fetch(b"^test3", (b"sub1", b"sub2")) == (_yottadb.YDB_DATA_VALUE_NODESC, b"test3value3")
+    # Handling of large values
+    _yottadb.set(varname="testlong", value=("a" * _yottadb.YDB_MAX_STR))
+    assert _yottadb.fetch(varname="testlong") == (_yottadb.YDB_DATA_VALUE_NODESC, b"a" * _yottadb.YDB_MAX_STR)
+    _yottadb.delete("testlong")
+
+
 def test_lock_incr_varname_only(new_db):
     # Varname only
     t1 = datetime.datetime.now()
@@ -582,6 +597,27 @@ def test_tp_return_YDB_ROLLBACK(new_db):
     _yottadb.delete("^tptests", delete_type=_yottadb.YDB_DEL_TREE)
 
 
+def test_tp_return_None(new_db):
+    calls = []
+
+    def callback(*args, **kwargs):
+        calls.append((args, kwargs))
+        _yottadb.set("^tptests", ("test_tp_return_None",), str(len(calls)))
+
+    # Positional and keyword arguments are passed through as is, and None commits the transaction
+    assert _yottadb.tp(callback) == _yottadb.YDB_OK
+    assert _yottadb.tp(callback, args=("a", 1)) == _yottadb.YDB_OK
+    assert _yottadb.tp(callback, args=("a",), kwargs={"b": 2}) == _yottadb.YDB_OK
+    assert _yottadb.tp(callback, kwargs={}) == _yottadb.YDB_OK
+    assert calls == [((), {}), (("a", 1), {}), (("a",), {"b": 2}), ((), {})]
+    assert _yottadb.get("^tptests", ("test_tp_return_None",)) == b"4"
+
+    with pytest.raises(TypeError):
+        _yottadb.tp(lambda: "not an int")
+    assert _yottadb.get("^tptests", ("test_tp_return_None",)) == b"4"
+    _yottadb.delete("^tptests", delete_type=_yottadb.YDB_DEL_TREE)
+
+
 def test_nested_return_YDB_ROLLBACK(new_db):
     node1 = ("^tptests", ("test_nested_return_YDB_ROLLBACK", "outer"))
     value1 = "return YDB_ROLLBACK"
@@ -921,6 +957,361 @@ def test_subscript_next_1(simple_data):
         _yottadb.subscript_next(varname="^test7", subsarray=(b"sub4\x80",))
 
 
+def test_subscript_count(simple_data):
+    assert _yottadb.subscript_count("^test4") == 3
+    assert _yottadb.subscript_count("^test4", ("sub1",)) == 3
+    assert _yottadb.subscript_count(varname=b"^test4", subsarray=(b"sub1", b"subsub1")) == 0
+    assert _yottadb.subscript_count("^test2") == 1
+    assert _yottadb.subscript_count("^nodata") == 0
+    # Subscripts longer than the default buffer size
+    _yottadb.set(varname="testLongSubscript", subsarray=("a" * _yottadb.YDB_MAX_STR,), value="toolong")
+    _yottadb.set(varname="testLongSubscript", subsarray=("b",), value="short")
+    assert _yottadb.subscript_count("testLongSubscript") == 2
+    _yottadb.delete("testLongSubscript", delete_type=_yottadb.YDB_DEL_TREE)
+
+
+def test_items(simple_data):
+    assert _yottadb.items("^test4", ("",)) == [(b"sub1", b"test4sub1"), (b"sub2", b"test4sub2"), (b"sub3", b"test4sub3")]
+    assert _yottadb.items("^test4", ("sub1",), count=1) == [(b"sub2", b"test4sub2")]
+    assert _yottadb.items("^test4", ("sub1", ""), data=True)[0] == (b"subsub1", b"test4sub1subsub1", _yottadb.YDB_DATA_VALUE_NODESC)
+    assert _yottadb.items("^test3", ("",), data=True) == [(b"sub1", b"test3value2", _yottadb.YDB_DATA_VALUE_DESC)]
+    assert _yottadb.items("^test4", ("sub3",)) == []
+    # Nodes without a value
+    _yottadb.set("testItems", ("a", "b"), "ab")
+    assert _yottadb.items("testItems", ("",)) == [(b"a", None)]
+    assert _yottadb.items("testItems", ("",), data=True) == [(b"a", None, _yottadb.YDB_DATA_NOVALUE_DESC)]
+    # Subscripts and values longer than the default buffer sizes
+    _yottadb.set("testItems", ("b" * _yottadb.YDB_MAX_STR,), "v" * _yottadb.YDB_MAX_STR)
+    assert _yottadb.items("testItems", ("a",)) == [(b"b" * _yottadb.YDB_MAX_STR, b"v" * _yottadb.YDB_MAX_STR)]
+    _yottadb.delete("testItems", delete_type=_yottadb.YDB_DEL_TREE)
+    with pytest.raises(ValueError):
+        _yottadb.items("^test4", ("",), count=-1)
+    with pytest.raises(_yottadb.YDBError):
+        _yottadb.items("^\x80", ("",))
+
+
+def test_subscript_scan(simple_data):
+    for sub in ("-1", "0", "1", "2", "10", "1.5", "a", "ab", "abc", "b", "ba"):
+        _yottadb.set("testScan", (sub,), sub)
+    all_subs = [b"-1", b"0", b"1", b"1.5", b"2", b"10", b"a", b"ab", b"abc", b"b", b"ba"]
+    assert _yottadb.subscript_scan("testScan", ("",)) == all_subs
+    assert _yottadb.subscript_scan("testScan", ("",), reverse=True) == all_subs[::-1]
+    # Boundaries
+    assert _yottadb.subscript_scan("testScan", ("",), start="1.5", stop="ab") == [b"1.5", b"2", b"10", b"a"]
+    assert _yottadb.subscript_scan("testScan", ("",), start="1.5", stop="ab", reverse=True) == [b"a", b"10", b"2", b"1.5"]
+    assert _yottadb.subscript_scan("testScan", ("",), start=b"2", stop="2") == []
+    assert _yottadb.subscript_scan("testScan", ("",), stop="", reverse=True) == []
+    assert _yottadb.subscript_scan("testScan", ("",), prefix="a") == [b"a", b"ab", b"abc"]
+    assert _yottadb.subscript_scan("testScan", ("",), prefix="a", reverse=True) == [b"abc", b"ab", b"a"]
+    assert _yottadb.subscript_scan("testScan", ("",), prefix="1") == [b"1", b"1.5", b"10"]
+    assert _yottadb.subscript_scan("testScan", ("",), prefix="1", reverse=True) == [b"10", b"1.5", b"1"]
+    assert _yottadb.subscript_scan("testScan", ("",), prefix="c") == []
+    assert _yottadb.subscript_scan("testScan", ("",), prefix="b", stop="ba") == [b"b"]
+    # Limits and resuming after a subscript
+    assert _yottadb.subscript_scan("testScan", ("",), count=2) == [b"-1", b"0"]
+    assert _yottadb.subscript_scan("testScan", ("0",), count=2) == [b"1", b"1.5"]
+    assert _yottadb.subscript_scan("testScan", ("a",), prefix="a") == [b"ab", b"abc"]
+    assert _yottadb.subscript_scan("testScan", ("a",), prefix="a", reverse=True) == []
+    assert _yottadb.subscript_scan("testScan", ("b",), start="a", reverse=True, count=1) == [b"abc"]
+    assert _yottadb.subscript_scan("testScan", ("abc",), count=0) == [b"b", b"ba"]
+    with pytest.raises(ValueError):
+        _yottadb.subscript_scan("testScan", ("",), count=-1)
+    with pytest.raises(TypeError):
+        _yottadb.subscript_scan("testScan", ("",), start=1)
+    # Variable names
+    assert _yottadb.subscript_scan("^test", start="^test2", stop="^test4") == [b"^test2", b"^test3"]
+    assert _yottadb.subscript_scan("^test7", reverse=True, count=1) == [b"^test6"]
+    _yottadb.delete("testScan", delete_type=_yottadb.YDB_DEL_TREE)
+    assert _yottadb.subscript_scan("testScan", ("",)) == []
+
+
+def test_subtree_stats(simple_data):
+    stats = _yottadb.subtree_stats("^test4")
+    assert stats["nodes"] == 13
+    assert stats["value_bytes"] == len("test4") + 3 * len("test4sub1") + 9 * len("test4sub1subsub1")
+    assert stats["max_depth"] == 2
+    assert stats["value_sizes"] == {8: 1, 16: 12}
+    assert stats["fanout"] == [{4: 1}, {4: 3}, {0: 9}]
+    assert stats["sample_rate"] == 1.0
+    assert _yottadb.subtree_stats("^test2")["fanout"] == [{1: 1}, {0: 1}]
+    assert _yottadb.subtree_stats("^test3", ("sub1", "sub2"))["fanout"] == [{0: 1}]
+    assert _yottadb.subtree_stats("^nodata") == {
+        "nodes": 0,
+        "value_bytes": 0,
+        "max_depth": 0,
+        "value_sizes": {},
+        "fanout": [],
+        "sample_rate": 1.0,
+    }
+    # Sampled subtrees are a subset of the children of the given node, all of which are counted
+    for i in range(100):
+        _yottadb.set("testStats", (str(i), "child"), "value")
+    stats = _yottadb.subtree_stats("testStats", sample_rate=0.5, seed=1)
+    assert 0 < stats["nodes"] < 100
+    assert stats["fanout"][0] == {128: 1}
+    assert stats["fanout"][1] == {1: stats["nodes"]}
+    assert stats == _yottadb.subtree_stats("testStats", sample_rate=0.5, seed=1)
+    _yottadb.delete("testStats", delete_type=_yottadb.YDB_DEL_TREE)
+    with pytest.raises(ValueError):
+        _yottadb.subtree_stats("^test4", sample_rate=0)
+    with pytest.raises(ValueError):
+        _yottadb.subtree_stats("^test4", sample_rate=1.5)
+
+
+def test_diff():
+    for subsarray, value in {("a",): "1", ("b",): "2", ("b", "x"): "3", ("c",): "4", ("e",): "v" * 2000}.items():
+        _yottadb.set("testDiffA", subsarray, value)
+    for subsarray, value in {(): "root", ("a",): "1", ("b",): "2!", ("b", "y"): "3", ("d",): "4", ("e",): "v" * 2000}.items():
+        _yottadb.set("testDiffB", subsarray, value)
+    differences = [
+        ((), "added", None, b"root"),
+        ((b"b",), "changed", b"2", b"2!"),
+        ((b"b", b"x"), "removed", b"3", None),
+        ((b"b", b"y"), "added", None, b"3"),
+        ((b"c",), "removed", b"4", None),
+        ((b"d",), "added", None, b"4"),
+    ]
+    assert _yottadb.diff("testDiffA", (), "testDiffB", ()) == (differences, None)
+    # Continue after the last difference returned
+    assert _yottadb.diff("testDiffA", (), "testDiffB", (), count=4) == (differences[:4], (b"b", b"y"))
+    assert _yottadb.diff("testDiffA", (), "testDiffB", (), (b"b", b"y"), 4) == (differences[4:], None)
+    assert _yottadb.diff("testDiffA", (), "testDiffB", (), (b"d",), 2) == ([], None)
+    # Subscripts are relative to the compared nodes
+    assert _yottadb.diff("testDiffA", ("b",), "testDiffB", ("b",)) == (
+        [((), "changed", b"2", b"2!"), ((b"x",), "removed", b"3", None), ((b"y",), "added", None, b"3")],
+        None,
+    )
+    assert _yottadb.diff("testDiffA", (), "testDiffA", ()) == ([], None)
+    assert _yottadb.diff("testDiffA", ("a",), "testDiffNoData", ()) == ([((), "removed", b"1", None)], None)
+    with pytest.raises(ValueError):
+        _yottadb.diff("testDiffA", (), "testDiffB", (), count=-1)
+    _yottadb.delete("testDiffA", delete_type=_yottadb.YDB_DEL_TREE)
+    _yottadb.delete("testDiffB", delete_type=_yottadb.YDB_DEL_TREE)
+
+
+def test_merged_nodes():
+    for name, subsarray, value in (
+        ("testMerged1", ("1",), "a"),
+        ("testMerged1", ("3",), "c"),
+        ("testMerged1", ("3", "x"), "cx"),
+        ("testMerged2", ("2",), "b"),
+        ("testMerged2", ("3",), "c2"),
+        ("testMerged2", ("10",), "j"),
+        ("testMerged3", ("east", "5"), "e5"),
+        ("testMerged3", ("west", "4"), "w4"),
+    ):
+        _yottadb.set(name, subsarray, value)
+    sources = [("testMerged1", ()), ("testMerged2", ()), ("testMerged3", ("east",)), ("testMerged3", ("west",))]
+    merged = [
+        (0, (b"1",), b"a"),
+        (1, (b"2",), b"b"),
+        (0, (b"3",), b"c"),
+        (1, (b"3",), b"c2"),
+        (0, (b"3", b"x"), b"cx"),
+        (3, (b"4",), b"w4"),
+        (2, (b"5",), b"e5"),
+        (1, (b"10",), b"j"),
+    ]
+    assert _yottadb.merged_nodes(sources) == merged
+    # Continue after the last node returned, including from a node with the same subscripts in a later input
+    assert _yottadb.merged_nodes(sources, count=3) == merged[:3]
+    assert _yottadb.merged_nodes(sources, (0, (b"3",)), 3) == merged[3:6]
+    assert _yottadb.merged_nodes(sources, (3, (b"4",))) == merged[6:]
+    assert _yottadb.merged_nodes(sources + [("testMergedNoData", ())]) == merged
+    assert _yottadb.merged_nodes([]) == []
+    with pytest.raises(TypeError):
+        _yottadb.merged_nodes([("testMerged1",)])
+    with pytest.raises(TypeError):
+        _yottadb.merged_nodes([("testMerged1", "sub")])
+
+    class NoLength:
+        def __getitem__(self, index):
+            return sources[index]
+
+    # An object with __getitem__() but no length passes as a sequence, but cannot be used as one
+    for invalid in (42, {"testMerged1": ()}, NoLength()):
+        with pytest.raises(TypeError):
+            _yottadb.merged_nodes(invalid)
+    for name in ("testMerged1", "testMerged2", "testMerged3"):
+        _yottadb.delete(name, delete_type=_yottadb.YDB_DEL_TREE)
+
+
+def test_child_init():
+    _yottadb.set("^testChildInit", value="parent")
+
+    def child():
+        _yottadb.child_init()
+        os._exit(0 if b"parent" == _yottadb.get("^testChildInit") else 1)
+
+    process = multiprocessing.get_context("fork").Process(target=child)
+    process.start()
+    process.join()
+    assert 0 == process.exitcode
+    _yottadb.delete("^testChildInit")
+
+
+def test_subinterpreter():
+    try:
+        import _interpreters as interpreters  # type: ignore
+    except ImportError:
+        interpreters = pytest.importorskip("_xxsubinterpreters")
+    # Each interpreter has its own module state, including its own exception types, and shares the database
+    interpreter = interpreters.create()
+    try:
+        interpreters.run_string(
+            interpreter,
+            "import sys\n"
+            f"sys.path.insert(0, {os.path.dirname(_yottadb.__file__)!r})\n"
+            "import _yottadb\n"
+            "_yottadb.set('^testSubinterpreter', ('set',), 'subinterpreter')\n"
+            "try:\n"
+            "    _yottadb.subscript_next('^testSubinterpreter', ('set',))\n"
+            "except _yottadb.YDBNodeEnd:\n"
+            "    _yottadb.set('^testSubinterpreter', ('raised',), 'YDBNodeEnd')\n",
+        )
+    finally:
+        interpreters.destroy(interpreter)
+    assert b"subinterpreter" == _yottadb.get("^testSubinterpreter", ("set",))
+    assert b"YDBNodeEnd" == _yottadb.get("^testSubinterpreter", ("raised",))
+    _yottadb.delete("^testSubinterpreter", delete_type=_yottadb.YDB_DEL_TREE)
+
+
+def test_template():
+    template = _yottadb.template("^testTemplate", (None, "bal", None))
+    _yottadb.template_set(template, ("1234", b"usd"), "100")
+    assert _yottadb.get("^testTemplate", ("1234", "bal", "usd")) == b"100"
+    assert _yottadb.template_get(template, ("1234", "usd")) == b"100"
+    assert _yottadb.template_get(template, ("1234", "eur")) is None
+    assert _yottadb.template_incr(template, ("1234", "usd"), "5") == b"105"
+    assert _yottadb.template_incr(template, (b"5678", "eur")) == b"1"
+    # A template without placeholders
+    assert _yottadb.template_get(_yottadb.template("^testTemplate", ("5678", "bal", "eur")), ()) == b"1"
+
+    # Invalid templates and params
+    with pytest.raises(TypeError):
+        _yottadb.template("^testTemplate", "1234")
+    with pytest.raises(TypeError):
+        _yottadb.template("^testTemplate", (None, 1))
+    with pytest.raises(ValueError):
+        _yottadb.template("^testTemplate", (None,) * (_yottadb.YDB_MAX_SUBS + 1))
+    with pytest.raises(ValueError):
+        _yottadb.template_get(template, ("1234",))
+    with pytest.raises(TypeError):
+        _yottadb.template_get(template, ("1234", 1))
+    with pytest.raises(ValueError):
+        _yottadb.template_get(template, ("1234", "a" * (_yottadb.YDB_MAX_STR + 1)))
+    with pytest.raises(ValueError):
+        _yottadb.template_get(("^testTemplate", ("1234",)), ())
+    _yottadb.delete("^testTemplate", delete_type=_yottadb.YDB_DEL_TREE)
+
+
+def test_atomic(new_db):
+    _yottadb.set("^testAtomic", ("balance",), "100")
+    results = _yottadb.atomic(
+        [
+            ("get", "^testAtomic", ("balance",)),
+            ("incr", "^testAtomic", ("balance",), "-30"),
+            ("set", "^testAtomic", ("log", "1"), b"withdraw 30"),
+            ("incr", "^testAtomic", ("count",)),
+            ("data", "^testAtomic"),
+            ("get", "^testAtomic", ("missing",)),
+            ("compare_and_set", "^testAtomic", ("balance",), "70", "75"),
+            ("delete", "^testAtomic", ("count",)),
+        ]
+    )
+    assert results == [b"100", b"70", None, b"1", 10, None, None, None]
+    assert _yottadb.get("^testAtomic", ("balance",)) == b"75"
+    assert _yottadb.data("^testAtomic", ("count",)) == 0
+    assert _yottadb.atomic([]) == []
+
+    # A failed compare_and_set rolls back every operation
+    ops = [("set", "^testAtomic", ("balance",), "0"), ("compare_and_set", "^testAtomic", ("claim",), "worker1", "worker2")]
+    assert _yottadb.atomic(ops) is None
+    assert _yottadb.get("^testAtomic", ("balance",)) == b"75"
+    # A None expected value requires the node to have no value, and a None new value deletes it
+    assert _yottadb.atomic([("compare_and_set", "^testAtomic", ("claim",), None, "worker1")]) == [None]
+    assert _yottadb.atomic([("compare_and_set", "^testAtomic", ("claim",), None, "worker2")]) is None
+    assert _yottadb.atomic([("compare_and_set", "^testAtomic", ("claim",), "worker1", None)]) == [None]
+    assert _yottadb.data("^testAtomic", ("claim",)) == 0
+
+    # Invalid operations
+    with pytest.raises(TypeError):
+        _yottadb.atomic(("get", "^testAtomic"))
+    with pytest.raises(ValueError):
+        _yottadb.atomic([("put", "^testAtomic", (), "1")])
+    with pytest.raises(ValueError):
+        _yottadb.atomic([("get", "^testAtomic", ("balance",)), ("compare_and_set", "^testAtomic", (), "1")])
+    with pytest.raises(TypeError):
+        _yottadb.atomic([("set", "^testAtomic", ("sub",), 1)])
+    with pytest.raises(TypeError):
+        _yottadb.atomic([("get", "^testAtomic", "balance")])
+    assert _yottadb.get("^testAtomic", ("balance",)) == b"75"
+    _yottadb.delete("^testAtomic", delete_type=_yottadb.YDB_DEL_TREE)
+
+
+def test_utf8_cache_stats():
+    _yottadb.utf8_cache_stats(reset=True)
+    _yottadb.set("testUTF8Cache", ("ascii",), "value")
+    assert _yottadb.utf8_cache_stats() == {"hits": 3, "misses": 0}
+    # A non-ASCII str may need to be encoded, so it is counted as a potential miss on each conversion
+    subscript = "".join(("sub", "\u00e9"))
+    _yottadb.set("testUTF8Cache", (subscript,), b"value")
+    assert _yottadb.utf8_cache_stats(reset=True) == {"hits": 4, "misses": 1}
+    assert _yottadb.get("testUTF8Cache", (subscript,)) == b"value"
+    assert _yottadb.utf8_cache_stats() == {"hits": 1, "misses": 1}
+    _yottadb.delete("testUTF8Cache", delete_type=_yottadb.YDB_DEL_TREE)
+
+
+def test_decode():
+    _yottadb.set("testDecode", ("caf\u00e9",), "cr\u00e8me")
+    _yottadb.set("testDecode", (b"\xff",), b"\xff")
+    assert _yottadb.get("testDecode", ("caf\u00e9",), decode="utf-8") == "cr\u00e8me"
+    assert _yottadb.get("testDecode", ("caf\u00e9",), decode=None) == "cr\u00e8me".encode()
+    assert _yottadb.get("testDecode", ("undefined",), decode="utf-8") is None
+    assert _yottadb.subscript_next("testDecode", ("",), decode="utf-8") == "caf\u00e9"
+    assert _yottadb.subscript_previous("testDecode", ("",), decode="latin-1") == "\u00ff"
+    assert _yottadb.node_next("testDecode", decode="utf-8") == ("caf\u00e9",)
+    assert _yottadb.node_previous("testDecode", ("caf\u00e9",), decode="utf-8", default=None) is None
+    # Invalid UTF-8 raises an exception unless an error handler is given
+    with pytest.raises(UnicodeDecodeError):
+        _yottadb.get("testDecode", (b"\xff",), decode="utf-8")
+    assert _yottadb.get("testDecode", (b"\xff",), decode="utf-8", errors="replace") == "\ufffd"
+    assert _yottadb.node_next("testDecode", ("caf\u00e9",), decode="utf-8", errors="surrogateescape") == ("\udcff",)
+    with pytest.raises(UnicodeDecodeError):
+        _yottadb.subscript_previous("testDecode", ("",), decode="utf-8")
+    with pytest.raises(LookupError):
+        _yottadb.get("testDecode", ("caf\u00e9",), decode="no-such-encoding")
+    _yottadb.delete("testDecode", delete_type=_yottadb.YDB_DEL_TREE)
+
+
+def test_aggregate():
+    values = {("a", "1"): "10", ("a", "2"): "2.5", ("a", "2", "x"): "1E2", ("b", "1"): "-3", ("b", "2"): "abc", ("c",): "7"}
+    for subsarray, value in values.items():
+        _yottadb.set("testAggregate", subsarray, value)
+    # Non-canonical numbers such as "1E2" and "abc" are ignored
+    assert _yottadb.aggregate("testAggregate") == (4, 16.5, -3.0, 10.0)
+    assert _yottadb.aggregate("testAggregate", ("b",)) == (1, -3, -3, -3)
+    assert _yottadb.aggregate("testAggregate", depth=1) == (1, 7, 7, 7)
+    assert _yottadb.aggregate("testAggregate", depth=0) == (0, 0, None, None)
+    assert _yottadb.aggregate("testAggregate", group_level=1) == {
+        b"a": (2, 12.5, 2.5, 10.0),
+        b"b": (1, -3, -3, -3),
+        b"c": (1, 7, 7, 7),
+    }
+    # Groups below the first level are merged across the subtrees of the nodes above them
+    assert _yottadb.aggregate("testAggregate", group_level=2, depth=2) == {b"1": (2, 7, -3, 10), b"2": (1, 2.5, 2.5, 2.5)}
+    assert _yottadb.aggregate("testAggregateNoData") == (0, 0, None, None)
+    # Integer sums fall back to floating point on overflow
+    _yottadb.delete("testAggregate", delete_type=_yottadb.YDB_DEL_TREE)
+    for i in range(10):
+        _yottadb.set("testAggregate", (str(i),), "9" * 18)
+    count, total, minimum, maximum = _yottadb.aggregate("testAggregate")
+    assert count == 10
+    assert isinstance(total, float) and total == pytest.approx(1e19)
+    assert isinstance(minimum, float) and minimum == maximum == pytest.approx(1e18)
+    _yottadb.delete("testAggregate", delete_type=_yottadb.YDB_DEL_TREE)
+
+
 def test_subscript_next_long():
     _yottadb.set(varname="testLongSubscript", subsarray=("a" * _yottadb.YDB_MAX_STR,), value="toolong")
     assert _yottadb.subscript_next(varname="testLongSubscript", subsarray=("",)) == b"a" * _yottadb.YDB_MAX_STR
@@ -971,6 +1362,53 @@ def test_node_next_1(simple_data):
     assert _yottadb.node_next("^test6") == (b"sub6", b"subsub6")
 
 
+def test_traversal_default(simple_data):
+    # A default value is returned instead of raising YDBNodeEnd
+    assert _yottadb.subscript_next("^test4", ("sub3",), None) is None
+    assert _yottadb.subscript_next(varname="^test4", subsarray=("sub3",), default=b"") == b""
+    assert _yottadb.subscript_next("^test4", ("sub1",), None) == b"sub2"
+    assert _yottadb.subscript_previous("^test4", ("sub1",), None) is None
+    assert _yottadb.subscript_previous("^test4", ("sub2",), None) == b"sub1"
+    assert _yottadb.node_next("^test3", ("sub1", "sub2"), None) is None
+    assert _yottadb.node_next("^test3", ("sub1",), None) == (b"sub1", b"sub2")
+    assert _yottadb.node_previous("^test3", (), None) is None
+    assert _yottadb.node_previous("^test3", ("sub1",), None) == ()
+
+
+def test_YDBError_code():
+    try:
+        _yottadb.incr("testerror", increment="1E48")
+        assert False
+    except YDBError as e:
+        # The error code is stored on the exception, and is both an attribute and callable for backward compatibility
+        assert _yottadb.YDB_ERR_NUMOFLOW == e.code
+        assert _yottadb.YDB_ERR_NUMOFLOW == e.code()
+        assert isinstance(e.code, int)
+        # The message is captured from $ZSTATUS when the exception is raised, and remains its first argument
+        assert e.args[1:] == (_yottadb.YDB_ERR_NUMOFLOW,)
+        assert e.args[0] == str(e)
+        assert str(e).startswith(f"{-_yottadb.YDB_ERR_NUMOFLOW},")
+        assert "NUMOFLOW" in str(e)
+        # A later error does not change the message
+        message = e.args[0]
+        with pytest.raises(YDBError):
+            _yottadb.incr("testerror", ("other",), increment="-1E48")
+        assert message == str(e)
+
+    try:
+        _yottadb.subscript_next("^test7", ())
+        assert False
+    except _yottadb.YDBNodeEnd as e:
+        assert _yottadb.YDB_ERR_NODEEND == e.code
+        assert str(e) == f"{_yottadb.YDB_ERR_NODEEND}, {_yottadb.message(_yottadb.YDB_ERR_NODEEND)}"
+
+    # Exceptions raised without an error code take the error code of their type, if any
+    assert _yottadb.YDB_TP_RESTART == _yottadb.YDBTPRestart().code
+    assert _yottadb.YDB_TP_ROLLBACK == _yottadb.YDBTPRollback("custom message").code
+    assert "custom message" == str(_yottadb.YDBTPRollback("custom message"))
+    assert _yottadb.YDBError().code is None
+
+
 def test_node_next_many_subscipts():
     _yottadb.set(varname="testmanysubscripts", subsarray=("sub1", "sub2", "sub3", "sub4", "sub5", "sub6"), value="123")
     assert _yottadb.node_next("testmanysubscripts") == (b"sub1", b"sub2", b"sub3", b"sub4", b"sub5", b"sub6")
@@ -988,6 +1426,85 @@ def test_node_previous_1(simple_data):
     assert _yottadb.node_previous("^test3", subsarray=("sub1", "sub2")) == (b"sub1",)
 
 
+def test_node_scan():
+    nodes = [(), ("1",), ("1", "a"), ("1", "b"), ("2",), ("2", "1"), ("2", "1", "x"), ("a",), ("a", "b")]
+    for node in nodes:
+        _yottadb.set("testScan", node, "value")
+    all_nodes = [tuple(sub.encode() for sub in node) for node in nodes]
+    assert _yottadb.node_scan("testScan") == all_nodes[1:]
+    assert _yottadb.node_scan("testScan", start=()) == all_nodes
+    assert _yottadb.node_scan("testScan", reverse=True) == all_nodes[::-1]
+    assert _yottadb.node_scan("testScan", ("1",), reverse=True) == [()]
+    # Boundaries
+    assert _yottadb.node_scan("testScan", start=("1", "b"), stop=("2", "1")) == [(b"1", b"b"), (b"2",)]
+    assert _yottadb.node_scan("testScan", start=("1", "b"), stop=("2", "1"), reverse=True) == [(b"2",), (b"1", b"b")]
+    assert _yottadb.node_scan("testScan", prefix=("2",)) == [(b"2",), (b"2", b"1"), (b"2", b"1", b"x")]
+    assert _yottadb.node_scan("testScan", prefix=("2",), reverse=True) == [(b"2", b"1", b"x"), (b"2", b"1"), (b"2",)]
+    assert _yottadb.node_scan("testScan", prefix=("1", "a")) == [(b"1", b"a")]
+    assert _yottadb.node_scan("testScan", prefix=("3",)) == []
+    assert _yottadb.node_scan("testScan", prefix=("3",), reverse=True) == []
+    assert _yottadb.node_scan("testScan", stop=(), reverse=True) == []
+    # Limits and resuming after a node
+    assert _yottadb.node_scan("testScan", count=3) == all_nodes[1:4]
+    assert _yottadb.node_scan("testScan", ("1", "b"), count=2) == all_nodes[4:6]
+    assert _yottadb.node_scan("testScan", ("2", "1"), prefix=("2",), reverse=True) == [(b"2",)]
+    with pytest.raises(ValueError):
+        _yottadb.node_scan("testScan", count=-1)
+    with pytest.raises(TypeError):
+        _yottadb.node_scan("testScan", start="1")
+    assert _yottadb.node_scan("^nodata") == []
+    _yottadb.delete("testScan", delete_type=_yottadb.YDB_DEL_TREE)
+
+
+def test_walk(simple_data):
+    assert _yottadb.walk("^test3") == [((), b"test3value1"), ((b"sub1",), b"test3value2"), ((b"sub1", b"sub2"), b"test3value3")]
+    assert _yottadb.walk("^test3", ("sub1",), relative=True) == [((), b"test3value2"), ((b"sub2",), b"test3value3")]
+    assert _yottadb.walk("^test3", cursor=(), count=1) == [((b"sub1",), b"test3value2")]
+    assert _yottadb.walk("^test2") == [((b"sub1",), b"test2value")]
+    assert _yottadb.walk("^test4", ("sub3",), cursor=("sub3", "subsub3")) == []
+    assert _yottadb.walk("^nodata") == []
+    # Subtrees below max_depth are skipped, including those of nodes without a value
+    for node in (("a",), ("a", "b"), ("a", "b", "c"), ("b", "x", "y"), ("c",)):
+        _yottadb.set("testWalk", node, "/".join(node))
+    assert _yottadb.walk("testWalk", max_depth=0) == []
+    assert _yottadb.walk("testWalk", max_depth=1) == [((b"a",), b"a"), ((b"c",), b"c")]
+    assert _yottadb.walk("testWalk", max_depth=2, relative=True) == [((b"a",), b"a"), ((b"a", b"b"), b"a/b"), ((b"c",), b"c")]
+    assert len(_yottadb.walk("testWalk")) == 5
+    _yottadb.delete("testWalk", delete_type=_yottadb.YDB_DEL_TREE)
+    with pytest.raises(ValueError):
+        _yottadb.walk("^test3", count=-1)
+
+
+def test_merge(simple_data):
+    assert _yottadb.merge("^test4", ("sub2",), "testMerge", ("copy",)) == (4, None)
+    assert _yottadb.get("testMerge", ("copy",)) == b"test4sub2"
+    assert _yottadb.get("testMerge", ("copy", "subsub3")) == b"test4sub2subsub3"
+    assert _yottadb.data("testMerge") == _yottadb.YDB_DATA_NOVALUE_DESC
+    # Existing values are only replaced if `overwrite` is set
+    _yottadb.set("testMerge", ("copy", "subsub1"), "existing")
+    assert _yottadb.merge("^test4", ("sub2",), "testMerge", ("copy",), overwrite=False) == (0, None)
+    assert _yottadb.get("testMerge", ("copy", "subsub1")) == b"existing"
+    assert _yottadb.merge("^test4", ("sub2",), "testMerge", ("copy",)) == (4, None)
+    assert _yottadb.get("testMerge", ("copy", "subsub1")) == b"test4sub2subsub1"
+    # Partial merges that can be resumed from the returned cursor
+    _yottadb.delete("testMerge", delete_type=_yottadb.YDB_DEL_TREE)
+    assert _yottadb.merge("^test4", (), "testMerge", (), count=2) == (2, (b"sub1",))
+    assert _yottadb.merge("^test4", (), "testMerge", (), cursor=(b"sub1",), count=20) == (11, None)
+    assert _yottadb.get("testMerge", ("sub3", "subsub3")) == b"test4sub3subsub3"
+    assert _yottadb.merge("^test2", (), "testMerge", ("test2",)) == (1, None)
+    assert _yottadb.get("testMerge", ("test2", "sub1")) == b"test2value"
+    assert _yottadb.merge("^nodata", (), "testMerge", ()) == (0, None)
+    # Merging a node with itself does nothing, and with its ancestors or descendants is not allowed
+    assert _yottadb.merge("testMerge", ("sub1",), "testMerge", ("sub1",)) == (0, None)
+    with pytest.raises(ValueError):
+        _yottadb.merge("testMerge", (), "testMerge", ("sub1",))
+    with pytest.raises(ValueError):
+        _yottadb.merge("testMerge", ("sub1",), "testMerge", ())
+    with pytest.raises(_yottadb.YDBError):
+        _yottadb.merge("^test4", (), "testMerge", ("a",) * _yottadb.YDB_MAX_SUBS)
+    _yottadb.delete("testMerge", delete_type=_yottadb.YDB_DEL_TREE)
+
+
 def test_node_previous_long_subscripts():
     _yottadb.set(varname="testlong", subsarray=("a" * 1025, "a" * 1026), value="123")
     _yottadb.set(varname="testlong", subsarray=("a" * 1025, "a" * 1026, "a"), value="123")
@@ -1201,6 +1718,66 @@ def test_incr_errors(node, initial, increment, error_type):
     teardown_db(db)
 
 
+def test_get_int(simple_data):
+    _yottadb.set("testint", value="42")
+    assert _yottadb.get_int("testint") == 42
+    _yottadb.set("testint", ("sub1",), "-123456789012345678")
+    assert _yottadb.get_int(varname="testint", subsarray=("sub1",)) == -123456789012345678
+    # Canonical numbers with more than 18 digits
+    _yottadb.set(b"testint", (b"sub2",), "1" + "0" * 46)
+    assert _yottadb.get_int(b"testint", (b"sub2",)) == 10**46
+    # Nodes without a value
+    assert _yottadb.get_int("testint", ("nosuchsub",)) is None
+    assert _yottadb.get_int("^testint") is None
+
+    # Non-integer values
+    for value in ("1.5", "abc", "", "-", " 1", "1" * (_yottadb.YDB_MAX_STR)):
+        _yottadb.set("testint", value=value)
+        with pytest.raises(ValueError):
+            _yottadb.get_int("testint")
+    with pytest.raises(ValueError):
+        _yottadb.get_int("^test1")
+
+
+def test_get_float(simple_data):
+    _yottadb.set("testfloat", value=".5")
+    assert _yottadb.get_float("testfloat") == 0.5
+    _yottadb.set("testfloat", ("sub1",), "-12")
+    assert _yottadb.get_float(varname="testfloat", subsarray=("sub1",)) == -12.0
+    assert isinstance(_yottadb.get_float("testfloat", ("sub1",)), float)
+    assert _yottadb.get_float("testfloat", ("nosuchsub",)) is None
+
+    # Non-numeric values
+    for value in ("abc", "", "inf", "nan", "0x10", "1.5abc"):
+        _yottadb.set("testfloat", value=value)
+        with pytest.raises(ValueError):
+            _yottadb.get_float("testfloat")
+
+
+def test_incr_int():
+    assert _yottadb.incr_int("testincrint") == 1
+    assert _yottadb.incr_int("testincrint", increment=41) == 42
+    assert _yottadb.incr_int("testincrint", None, -50) == -8
+    assert _yottadb.get("testincrint") == b"-8"
+    assert _yottadb.incr_int("^testincrint", ("sub1",), 10) == 10
+    assert _yottadb.incr_int(b"^testincrint", (b"sub1",), 999999999999999989) == 999999999999999999
+    _yottadb.delete("^testincrint", delete_type=_yottadb.YDB_DEL_TREE)
+
+    # A non-integer value yields a non-integer result
+    _yottadb.set("testincrint", value="1.5")
+    assert _yottadb.incr_int("testincrint") == 2.5
+
+    # Invalid increments
+    with pytest.raises(TypeError):
+        _yottadb.incr_int("testincrint", increment="1")
+    with pytest.raises(TypeError):
+        _yottadb.incr_int("testincrint", increment=1.0)
+    with pytest.raises(TypeError):
+        _yottadb.incr_int("testincrint", increment=True)
+    with pytest.raises(OverflowError):
+        _yottadb.incr_int("testincrint", increment=2**64)
+
+
 @pytest.mark.parametrize("input, output1, output2", str2zwr_tests)
 def test_str2zwr(input, output1, output2):
     if os.environ.get("ydb_chset") == "UTF-8":
@@ -43,13 +43,12 @@ def test_wordfreq(new_db):
             for word in words:
                 yottadb.incr(words_var, (word.encode(),))
 
-    for subscript in yottadb.subscripts(words_var, (b"",)):
-        count = yottadb.get(words_var, (subscript,))
+    for subscript, count in yottadb.items(words_var, decode="utf-8"):
         yottadb.set(index_var, (count, subscript), b"")
 
     with open("wordfreq.out", "w") as output_file:
-        for word in reversed(yottadb.subscripts(index_var, (b"",))):
-            for count in yottadb.subscripts(index_var, (word, b"")):
+        for word in reversed(yottadb.subscripts(index_var, (b"",), decode="utf-8")):
+            for count in yottadb.subscripts(index_var, (word, b""), decode="utf-8"):
                 output_file.write(f"{word}\t{count}\n")
 
     yottadb.delete_tree(words_var)
@@ -22,6 +22,8 @@ import time
 import os
 import re
 import sys
+import itertools
+import threading
 import requests
 from urllib.request import urlretrieve
 from typing import NamedTuple, Callable, Tuple, Sequence, AnyStr
@@ -474,6 +476,26 @@ def test_Node_set_value3():
     assert yottadb.Node("test5")["sub1"] == b"test5value"
 
 
+def test_Node_int_value():
+    testnode = yottadb.Node("testintvalue")["sub1"]
+    assert testnode.int_value is None
+    testnode.int_value = 5
+    assert testnode.value == b"5"
+    assert testnode.int_value == 5
+    testnode.incr(-7)
+    assert testnode.int_value == -2
+    assert yottadb.incr_int(testnode.name, testnode.subsarray, 3) == 1
+    with pytest.raises(TypeError):
+        testnode.int_value = "5"
+    with pytest.raises(TypeError):
+        testnode.int_value = True
+    testnode.value = "five"
+    with pytest.raises(ValueError):
+        testnode.int_value
+    testnode.value = "2.5"
+    assert yottadb.get_float(testnode.name, testnode.subsarray) == 2.5
+
+
 def test_Node_delete_node():
     testnode = yottadb.Node("test6")
     subnode = testnode["sub1"]
@@ -519,6 +541,409 @@ def test_Node_data(simple_data):
         yottadb.Node("^\x80").data
 
 
+def test_Node_fetch(simple_data):
+    assert yottadb.Node("nodata").fetch() == (yottadb.YDB_DATA_UNDEF, None)
+    assert yottadb.Node("^test2").fetch() == (yottadb.YDB_DATA_NOVALUE_DESC, None)
+    assert yottadb.Node("^test3")["sub1"].fetch() == (yottadb.YDB_DATA_VALUE_DESC, b"test3value2")
+    assert yottadb.fetch("^test3", ("sub1", "sub2")) == (yottadb.YDB_DATA_VALUE_NODESC, b"test3value3")
+
+    # Confirm errors from C API are raised as YDBError exceptions
+    with pytest.raises(yottadb.YDBError):
+        yottadb.Node("^\x80").fetch()
+
+
+def test_items(simple_data, monkeypatch):
+    expected = [(b"sub1", b"test4sub1"), (b"sub2", b"test4sub2"), (b"sub3", b"test4sub3")]
+    assert list(yottadb.items("^test4")) == expected
+    assert list(yottadb.Node("^test4").items()) == expected
+    assert list(yottadb.Node("^test4")["sub2"].items(data=True)) == [
+        (b"subsub1", b"test4sub2subsub1", yottadb.YDB_DATA_VALUE_NODESC),
+        (b"subsub2", b"test4sub2subsub2", yottadb.YDB_DATA_VALUE_NODESC),
+        (b"subsub3", b"test4sub2subsub3", yottadb.YDB_DATA_VALUE_NODESC),
+    ]
+    assert list(yottadb.items("^test2")) == [(b"sub1", b"test2value")]
+    assert list(yottadb.Node("nodata").items()) == []
+    # Use a small chunk size to exercise resuming after each chunk
+    monkeypatch.setattr(yottadb, "scan_chunk_size", 2)
+    assert list(yottadb.items("^test4")) == expected
+
+
+def test_walk(simple_data, monkeypatch):
+    # Use a small chunk size to exercise resuming after each chunk
+    monkeypatch.setattr(yottadb, "scan_chunk_size", 2)
+    test4 = [(node_subs, value) for (name, node_subs), value in SIMPLE_DATA if "^test4" == name]
+    assert [(tuple(sub.decode() for sub in subs), value.decode()) for subs, value in yottadb.walk("^test4")] == test4
+    assert list(yottadb.Node("^test4")["sub2"].walk(relative=True)) == [
+        ((), b"test4sub2"),
+        ((b"subsub1",), b"test4sub2subsub1"),
+        ((b"subsub2",), b"test4sub2subsub2"),
+        ((b"subsub3",), b"test4sub2subsub3"),
+    ]
+    assert list(yottadb.Node("^test4").walk(max_depth=1)) == [
+        ((), b"test4"),
+        ((b"sub1",), b"test4sub1"),
+        ((b"sub2",), b"test4sub2"),
+        ((b"sub3",), b"test4sub3"),
+    ]
+    with pytest.raises(ValueError):
+        list(yottadb.walk("^test4", max_depth=-1))
+
+
+def test_merge(simple_data):
+    test4 = {subs: value for subs, value in yottadb.walk("^test4", relative=True)}
+    assert yottadb.merge(yottadb.Node("^test4"), yottadb.Node("^testMerge")["copy"]) == 13
+    assert {subs: value for subs, value in yottadb.walk("^testMerge", ("copy",), relative=True)} == test4
+    yottadb.delete_tree("^testMerge")
+    # Merge in transactions of a few nodes each
+    assert yottadb.merge(("^test4", ()), ("^testMerge", ()), chunk_size=3) == 13
+    assert {subs: value for subs, value in yottadb.walk("^testMerge")} == test4
+    assert yottadb.merge(("^test4", ("sub1",)), ("^testMerge", ("sub2",)), overwrite=False, chunk_size=2) == 0
+    assert yottadb.get("^testMerge", ("sub2",)) == b"test4sub2"
+    yottadb.delete_tree("^testMerge")
+    with pytest.raises(ValueError):
+        yottadb.merge(("^test4", ()), ("^testMerge", ()), chunk_size=0)
+
+
+def test_subtree_stats(simple_data):
+    stats = yottadb.subtree_stats("^test3")
+    assert (stats["nodes"], stats["max_depth"], stats["fanout"]) == (3, 2, [{1: 1}, {1: 1}, {0: 1}])
+    assert stats["value_bytes"] == len("test3value1") + len("test3value2") + len("test3value3")
+    # The sampled children vary, but the number of children of the given node does not
+    stats = yottadb.subtree_stats("^test4", sample_rate=0.1)
+    assert stats["fanout"][0] == {4: 1}
+    assert stats["nodes"] in (1, 5, 9, 13)
+
+
+def test_diff():
+    today = yottadb.Node("testDiffToday")
+    for i in range(yottadb.scan_chunk_size + 10):
+        yottadb.set("testDiffYesterday", ("orders", str(i)), "pending")
+        today["orders"][str(i)].value = "shipped" if 0 == i % 2 else "pending"
+    differences = list(yottadb.diff(("testDiffYesterday", ("orders",)), today["orders"]))
+    assert len(differences) == (yottadb.scan_chunk_size + 10) // 2
+    assert differences[0] == ((b"0",), "changed", b"pending", b"shipped")
+    assert all("changed" == kind for _, kind, _, _ in differences)
+    assert [] == list(yottadb.diff(today, today))
+    yottadb.delete("testDiffYesterday", delete_type=yottadb.YDB_DEL_TREE)
+    today.delete_tree()
+
+
+def test_merged_nodes():
+    shards = [yottadb.Node(f"testShard{i}") for i in range(3)]
+    for i in range(yottadb.scan_chunk_size + 10):
+        shards[i % 3][f"{i:05}"].value = str(i)
+    merged = list(yottadb.merged_nodes(shards))
+    assert [int(value) for _, _, value in merged] == list(range(yottadb.scan_chunk_size + 10))
+    assert merged[4] == (1, (b"00004",), b"4")
+    # Tuples and Node objects may be mixed
+    assert list(yottadb.merged_nodes([("testShard0", (b"00000",)), shards[1]["00001"]])) == [(0, (), b"0"), (1, (), b"1")]
+    for shard in shards:
+        shard.delete_tree()
+
+
+def test_parallel_scan():
+    orders = yottadb.Node("^testParallelScan")
+    for i in range(101):
+        orders[str(i)]["total"].value = str(i)
+    ranges = [(None, b"25"), (b"25", b"50"), (b"50", b"75"), (b"75", None)]
+    assert yottadb.parallel_scan_ranges("^testParallelScan", (), 4) == ranges
+    assert yottadb.parallel_scan(orders, lambda order: int(order["total"].value), lambda a, b: a + b, workers=4) == 5050
+    # Without a reduction, the results of all workers are returned in subscript order
+    assert yottadb.parallel_scan(orders, lambda order: order.subsarray[-1], workers=3) == [str(i).encode() for i in range(101)]
+    assert yottadb.parallel_scan(("^testParallelScanNoData", ()), lambda order: 1, lambda a, b: a + b, initial=0) == 0
+    # None is a valid initial value
+    assert yottadb.parallel_scan(("^testParallelScanNoData", ()), lambda order: 1, lambda a, b: a + b) is None
+    yottadb.set("^testParallelScanOne", ("1",), "1")
+    one = ("^testParallelScanOne", ())
+    assert yottadb.parallel_scan(one, lambda order: 1, lambda a, b: (a, b), initial=None, workers=1) == (None, 1)
+    yottadb.delete_tree("^testParallelScanOne")
+    assert yottadb.parallel_scan(("^testParallelScanNoData", ()), lambda order: 1, lambda a, b: a + b, initial=None) is None
+    with pytest.raises(ZeroDivisionError):
+        yottadb.parallel_scan(orders, lambda order: 1 / 0, workers=2)
+    with pytest.raises(ValueError):
+        yottadb.parallel_scan(orders, lambda order: 1, workers=0)
+    orders.delete_tree()
+
+
+def test_WorkerPool():
+    for i in range(10):
+        yottadb.set("^testWorkerPool", (str(i),), str(i * i))
+    # Local variables set by the warmup function are inherited by the workers
+    with yottadb.WorkerPool(2, warmup=lambda: yottadb.set("testWorkerPoolWarm", value="warm")) as pool:
+        values = pool.starmap(yottadb.get, [("^testWorkerPool", (str(i),)) for i in range(10)])
+        assert values == [str(i * i).encode() for i in range(10)]
+        assert pool.apply(yottadb.get, ("testWorkerPoolWarm",)) == b"warm"
+    yottadb.delete("testWorkerPoolWarm")
+    yottadb.delete("^testWorkerPool", delete_type=yottadb.YDB_DEL_TREE)
+
+    # The call-in table of the pool does not remain active in the current process
+    handle = yottadb.open_ci_table(os.getcwd() + "/tests/calltab.ci")
+    yottadb.switch_ci_table(handle)
+    with yottadb.WorkerPool(1, ci_table=os.getcwd() + "/tests/testcalltab.ci") as pool:
+        assert pool.apply(yottadb.get, ("^testWorkerPool",)) is None
+    assert yottadb.switch_ci_table(handle) == handle
+
+
+def test_fork_child_init():
+    yottadb.set("^testForkChildInit", value="parent")
+    # YottaDB is reinitialized in the child process without an explicit call to child_init()
+    pid = os.fork()
+    if 0 == pid:
+        os._exit(0 if b"parent" == yottadb.get("^testForkChildInit") else 1)
+    _, status = os.waitpid(pid, 0)
+    assert 0 == os.waitstatus_to_exitcode(status)
+    yottadb.delete("^testForkChildInit")
+
+
+def test_threads():
+    # Module functions called from several threads at once are serialized, so no increment is lost, including when
+    # the GIL is disabled in free-threaded builds of Python
+    counter = yottadb.Node("^testThreads")
+    counter.value = "0"
+
+    def work(thread: int) -> None:
+        for i in range(200):
+            counter.incr()
+            yottadb.set("^testThreads", (str(thread), str(i)), str(i))
+            yottadb.tp(lambda: counter["tp"].incr() and yottadb.YDB_OK)
+
+    threads = [threading.Thread(target=work, args=(thread,)) for thread in range(8)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    assert int(counter.value) == 1600
+    assert int(counter["tp"].value) == 1600
+    assert all(200 == yottadb.subscript_count("^testThreads", (str(thread),)) for thread in range(8))
+    counter.delete_tree()
+
+
+def test_template():
+    balance = yottadb.template("^testTemplate", (yottadb.PARAM, "bal"))
+    balance.set("1234", "100")
+    assert yottadb.get("^testTemplate", ("1234", "bal")) == b"100"
+    assert balance.get("1234") == b"100"
+    assert balance.get("5678") is None
+    assert balance.incr("1234", increment=5) == b"105"
+    assert balance.incr(b"5678") == b"1"
+    email = yottadb.Template("^testTemplate", ("email", yottadb.PARAM, yottadb.PARAM))
+    email.set("a@example.com", "1234", "")
+    assert list(yottadb.Node("^testTemplate")["email"]["a@example.com"].subscripts) == [b"1234"]
+    with pytest.raises(ValueError):
+        balance.get("1234", "5678")
+    with pytest.raises(TypeError):
+        balance.set()
+    yottadb.delete_tree("^testTemplate")
+
+
+def test_atomic():
+    account = yottadb.Node("^testAtomic")["1234"]
+    account.value = "100"
+    assert yottadb.atomic([("incr", account, "-30"), ("get", "^testAtomic", ("1234",)), ("delete_tree", account)]) == [
+        b"70",
+        b"70",
+        None,
+    ]
+    assert account.value is None
+    assert yottadb.atomic([("compare_and_set", account, "100", "0")]) is None
+    assert yottadb.atomic([("compare_and_set", account, None, "0")]) == [None]
+    assert account.value == b"0"
+    yottadb.delete_tree("^testAtomic")
+
+
+def test_compare_and_set():
+    job = yottadb.Node("^testCAS")["job1"]
+    assert job.set_if_absent("worker1")
+    assert not job.set_if_absent("worker2")
+    assert job.value == b"worker1"
+    assert not job.compare_and_set("worker2", "worker3")
+    assert job.compare_and_set("worker1", "done")
+    assert job.value == b"done"
+    assert not job.delete_if_equals("worker1")
+    assert job.delete_if_equals(b"done")
+    assert job.value is None
+    assert not yottadb.delete_if_equals("^testCAS", ("job1",), "done")
+    assert yottadb.compare_and_set("^testCAS", ("job2",), None, "worker1")
+    assert yottadb.compare_and_set("^testCAS", ("job2",), "worker1", None)
+    assert yottadb.data("^testCAS") == 0
+    with pytest.raises(TypeError):
+        job.delete_if_equals(None)
+    with pytest.raises(TypeError):
+        job.set_if_absent(None)
+    # With no expected value and no new value, the node is left unchanged and the result reports whether it has no value
+    assert yottadb.compare_and_set("^testCAS", ("job3",), None, None)
+    yottadb.set("^testCAS", ("job3",), "worker1")
+    assert not yottadb.compare_and_set("^testCAS", ("job3",), None, None)
+    assert yottadb.get("^testCAS", ("job3",)) == b"worker1"
+    yottadb.delete_tree("^testCAS")
+
+
+def test_AtomicBatch():
+    account = yottadb.Node("^testAtomicBatch")["1234"]
+    with yottadb.AtomicBatch() as batch:
+        batch.set(account, "100")
+        batch.incr(account, -30)
+        batch.get(("^testAtomicBatch", ("1234",)))
+        batch.data(yottadb.Node("^testAtomicBatch"))
+        assert len(batch) == 4
+        assert account.value is None
+    assert batch.applied
+    assert batch.results == [None, b"70", b"70", 10]
+    assert len(batch) == 0
+
+    # A failed compare_and_set applies none of the operations
+    with yottadb.AtomicBatch() as batch:
+        batch.compare_and_set(account, "100", "0")
+        batch.delete_tree(account)
+    assert not batch.applied
+    assert account.value == b"70"
+
+    # An exception in the block discards the batch
+    with pytest.raises(ZeroDivisionError):
+        with yottadb.AtomicBatch() as batch:
+            batch.delete_node(account)
+            1 / 0
+    assert account.value == b"70"
+    yottadb.delete_tree("^testAtomicBatch")
+
+
+def test_GroupCommitter(monkeypatch):
+    # The group is only committed when the batches of all workers have joined it, since together they reach max_ops
+    committer = yottadb.GroupCommitter(window=60, max_ops=16)
+    counter = yottadb.Node("^testGroupCommitter")["counter"]
+    outcomes = {}
+    calls = []
+    atomic = yottadb._yottadb.atomic
+
+    def counting_atomic(*args):
+        calls.append(len(args[0]))
+        return atomic(*args)
+
+    def submit(worker):
+        if 3 == worker:
+            # A batch whose compare_and_set fails does not prevent the other batches from applying
+            outcomes[worker] = committer.submit([("compare_and_set", counter, "unexpected", "0"), ("delete_tree", counter)])
+        else:
+            ops = [("incr", counter), ("set", "^testGroupCommitter", ("worker", str(worker)), "done")]
+            outcomes[worker] = committer.submit(ops)
+
+    monkeypatch.setattr(yottadb._yottadb, "atomic", counting_atomic)
+    threads = [threading.Thread(target=submit, args=(worker,)) for worker in range(8)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    monkeypatch.undo()
+    # One transaction for the whole group, which did not apply, then one for each batch
+    assert calls == [16] + [2] * 8
+    assert outcomes.pop(3) is None
+    assert sorted(int(results[0]) for results in outcomes.values()) == list(range(1, 8))
+    assert all(results[1] is None for results in outcomes.values())
+    assert counter.value == b"7"
+    assert len(list(yottadb.Node("^testGroupCommitter")["worker"].subscripts)) == 7
+
+    # Errors are raised to the caller of the batch that caused them
+    with pytest.raises(TypeError):
+        yottadb.GroupCommitter(window=0).submit([("set", counter, 1)])
+    batch = yottadb.AtomicBatch()
+    batch.get(counter)
+    assert yottadb.GroupCommitter(window=0).submit(batch) == [b"7"]
+    assert batch.results == [b"7"] and batch.applied
+
+    # A batch submitted from a transaction is executed immediately, rather than joining a group whose leader could not
+    # commit it while the transaction holds the API lock. The group of the other thread is completed by a later batch.
+    committer = yottadb.GroupCommitter(window=60, max_ops=2)
+    started = threading.Event()
+
+    def submit_incr():
+        started.set()
+        outcomes["thread"] = committer.submit([("incr", counter)])
+
+    def callback():
+        outcomes["tp"] = committer.submit([("incr", counter)])
+        return yottadb.YDB_OK
+
+    thread = threading.Thread(target=submit_incr)
+    thread.start()
+    started.wait()
+    yottadb.tp(callback)
+    outcomes["main"] = committer.submit([("incr", counter)])
+    thread.join()
+    assert outcomes["tp"] == [b"8"]
+    assert sorted((outcomes["thread"][0], outcomes["main"][0])) == [b"10", b"9"]
+
+    # If committing a group fails, the error is raised to the caller of every batch of the group
+    class CommitAborted(BaseException):
+        pass
+
+    def failing_atomic(*args):
+        raise CommitAborted()
+
+    committer = yottadb.GroupCommitter(window=60, max_ops=3)
+    errors = []
+
+    def failing_submit():
+        try:
+            committer.submit([("incr", counter)])
+        except CommitAborted as error:
+            errors.append(error)
+
+    monkeypatch.setattr(yottadb._yottadb, "atomic", failing_atomic)
+    threads = [threading.Thread(target=failing_submit) for _ in range(3)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    monkeypatch.undo()
+    assert 3 == len(errors)
+    assert counter.value == b"10"
+    # The committer is not left waiting for the failed group
+    assert committer.submit([("incr", counter)] * 3) == [b"11", b"12", b"13"]
+    yottadb.delete_tree("^testGroupCommitter")
+
+
+def test_decode():
+    node = yottadb.Node("testDecode")["caf\u00e9"]
+    node.value = "cr\u00e8me"
+    assert node.get(decode="utf-8") == "cr\u00e8me"
+    assert yottadb.get("testDecode", ("caf\u00e9",), decode="utf-8") == "cr\u00e8me"
+    assert yottadb.subscript_next("testDecode", ("",), decode="utf-8") == "caf\u00e9"
+    assert yottadb.node_next("testDecode", decode="utf-8") == ("caf\u00e9",)
+    yottadb.set("testDecode", ("invalid",), b"\xff")
+    assert yottadb.get("testDecode", ("invalid",), decode="utf-8", errors="backslashreplace") == "\\xff"
+    # Iterators decode subscripts and values, and resume exactly even if the decoding is lossy
+    assert list(yottadb.subscripts("testDecode", ("",), decode="utf-8")) == ["caf\u00e9", "invalid"]
+    assert list(yottadb.subscripts("testDecode", ("",), reverse=True, decode="latin-1")) == ["invalid", "caf\u00c3\u00a9"]
+    expected = [("caf\u00e9", "cr\u00e8me"), ("invalid", "\ufffd")]
+    assert list(yottadb.items("testDecode", decode="utf-8", errors="replace")) == expected
+    assert list(yottadb.Node("testDecode").walk(decode="utf-8", errors="replace")) == [
+        (("caf\u00e9",), "cr\u00e8me"),
+        (("invalid",), "\ufffd"),
+    ]
+    yottadb.set("testDecode", (b"\xff",), "x")
+    yottadb.set("testDecode", (b"\xfe",), "y")
+    # Both subscripts decode to the same str, so a decoded cursor could not resume after the first one
+    assert list(yottadb.subscripts("testDecode", ("invalid",), decode="utf-8", errors="replace")) == ["\ufffd", "\ufffd"]
+    yottadb.delete_tree("testDecode")
+
+
+def test_aggregate():
+    for region, month, amount in (("east", "1", "10"), ("east", "2", "20"), ("west", "1", "5"), ("west", "2", "n/a")):
+        yottadb.set("testAggregate", (region, month), amount)
+    assert yottadb.aggregate("testAggregate") == {"sum": 35, "count": 3, "min": 5, "max": 20}
+    assert yottadb.aggregate("testAggregate", ops=("mean",), depth=2) == {"mean": 35 / 3}
+    assert yottadb.aggregate("testAggregate", ops=("count", "sum"), group_by=1) == {
+        b"east": {"count": 2, "sum": 30},
+        b"west": {"count": 1, "sum": 5},
+    }
+    assert yottadb.aggregate("testAggregateNoData", ops=("count", "mean")) == {"count": 0, "mean": None}
+    with pytest.raises(ValueError):
+        yottadb.aggregate("testAggregate", ops=("median",))
+    with pytest.raises(ValueError):
+        yottadb.aggregate("testAggregate", group_by=0)
+    yottadb.delete("testAggregate", delete_type=yottadb.YDB_DEL_TREE)
+
+
 def test_Node_has_value(simple_data):
     assert not yottadb.Node("nodata").has_value
     assert yottadb.Node("^test1").has_value
@@ -590,6 +1015,44 @@ def test_Node_mutate(new_db):
     assert node1 is node2
 
 
+def test_Node_structural_sharing(new_db):
+    root = yottadb.Node("testsharing")
+    child = root["sub1"]
+    grandchild = child["sub2"]
+    # Children link to their parent rather than copying its subscripts
+    assert grandchild.parent is child
+    assert child.parent is root
+    assert grandchild.subsarray == ["sub1", "sub2"]
+    assert grandchild == yottadb.Node("testsharing", ("sub1", "sub2"))
+    assert root("sub1", "sub2") == grandchild
+    assert grandchild.copy() == grandchild
+
+    # Equal nodes hash equally, whether linked or created from a subscript array
+    assert hash(grandchild) == hash(yottadb.Node("testsharing", ["sub1", "sub2"]))
+    assert len({grandchild, root("sub1", "sub2"), child}) == 2
+    # A node still equals its value, although its hash only depends on its path, and mutable nodes are not hashable
+    root.value = "root"
+    assert root == b"root" and hash(root) == hash(yottadb.Node("testsharing"))
+    root["a"].value = "a"
+    node = next(iter(root))
+    with pytest.raises(TypeError):
+        hash(node)
+    assert hash(node.copy()) == hash(yottadb.Node("testsharing", node.subsarray))
+
+    # Children of a mutable node do not change when the mutable node does
+    for sub in ("a", "b", "c"):
+        root[sub].value = sub
+    children = [node["x"] for node in root]
+    assert [node.subsarray for node in children] == [[b"a", "x"], [b"b", "x"], [b"c", "x"]]
+
+    deepest = root
+    for i in range(yottadb.YDB_MAX_SUBS):
+        deepest = deepest[str(i)]
+    assert len(deepest.subsarray) == yottadb.YDB_MAX_SUBS
+    with pytest.raises(ValueError):
+        deepest["overflow"]
+
+
 def test_Node_subscript_next(new_db):
     node1 = yottadb.Node("testsubsnext1")
     node2 = yottadb.Node("testsubsnext2")
@@ -1307,6 +1770,72 @@ def test_subscripts_iter(simple_data):
         assert yottadb.YDB_ERR_INVVARNAME == e.code()
 
 
+def test_reversed_iter_lazy(simple_data, monkeypatch):
+    # Use a small chunk size and count the chunks retrieved to confirm the last N entries are read without reading the rest
+    monkeypatch.setattr(yottadb, "scan_chunk_size", 2)
+    calls = []
+
+    def count_calls(function: Callable) -> Callable:
+        def wrapper(*args, **kwargs):
+            calls.append(args)
+            return function(*args, **kwargs)
+
+        return wrapper
+
+    monkeypatch.setattr(yottadb._yottadb, "node_scan", count_calls(yottadb._yottadb.node_scan))
+    monkeypatch.setattr(yottadb._yottadb, "subscript_scan", count_calls(yottadb._yottadb.subscript_scan))
+    for i in range(100):
+        yottadb.set("testReversed", (str(i),), str(i))
+    assert list(itertools.islice(reversed(yottadb.subscripts("testReversed", ("",))), 3)) == [b"99", b"98", b"97"]
+    assert 2 == len(calls)
+    calls.clear()
+    assert list(itertools.islice(reversed(yottadb.nodes("testReversed")), 3)) == [(b"99",), (b"98",), (b"97",)]
+    assert 2 == len(calls)
+    assert 100 == len(list(reversed(yottadb.subscripts("testReversed", ("",)))))
+    yottadb.delete_tree("testReversed")
+
+    # A variable with only a root node
+    yottadb.set("testReversed", (), "root")
+    assert list(reversed(yottadb.nodes("testReversed"))) == [()]
+    yottadb.delete_tree("testReversed")
+    assert list(reversed(yottadb.nodes("testReversed"))) == []
+
+
+def test_subscripts_and_nodes_range(simple_data, monkeypatch):
+    # Use a small chunk size to exercise resuming a scan after each chunk
+    monkeypatch.setattr(yottadb, "scan_chunk_size", 2)
+    for sub in ("1", "2", "10", "cust:1", "cust:2", "cust:3", "order:1"):
+        yottadb.set("testRange", (sub, "x"), sub)
+    assert list(yottadb.subscripts("testRange", ("",), prefix="cust:")) == [b"cust:1", b"cust:2", b"cust:3"]
+    assert list(yottadb.subscripts("testRange", ("",), prefix="cust:", reverse=True)) == [b"cust:3", b"cust:2", b"cust:1"]
+    assert list(yottadb.subscripts("testRange", ("",), start="2", stop="cust:2")) == [b"2", b"10", b"cust:1"]
+    assert list(yottadb.subscripts("testRange", ("",), start="2", limit=3)) == [b"2", b"10", b"cust:1"]
+    assert list(yottadb.subscripts("testRange", ("",), limit=0)) == []
+    reverse_subs = [b"order:1", b"cust:3", b"cust:2", b"cust:1", b"10"]
+    assert list(yottadb.subscripts("testRange", ("",), reverse=True, limit=5)) == reverse_subs
+    assert list(yottadb.subscripts("^%", start="^test2", stop="^test6")) == [b"^test2", b"^test3", b"^test4"]
+    with pytest.raises(ValueError):
+        yottadb.subscripts("testRange", ("",), limit=-1)
+    # The same iterator type is returned with or without boundaries, and reversing a bounded iterator keeps its boundaries
+    assert isinstance(yottadb.subscripts("testRange", ("",), prefix="cust:"), yottadb.SubscriptsIter)
+    assert list(reversed(yottadb.subscripts("testRange", ("",), prefix="cust:"))) == [b"cust:3", b"cust:2", b"cust:1"]
+    assert isinstance(yottadb.nodes("testRange", limit=1), yottadb.NodesIter)
+    assert list(reversed(yottadb.nodes("testRange", prefix=("cust:",)))) == []
+    assert list(reversed(yottadb.nodes("testRange", prefix=("cust:2",)))) == [(b"cust:2", b"x")]
+
+    assert list(yottadb.nodes("testRange", prefix=("cust:2",))) == [(b"cust:2", b"x")]
+    assert list(yottadb.nodes("testRange", start=("10",), stop=("cust:3",))) == [
+        (b"10", b"x"),
+        (b"cust:1", b"x"),
+        (b"cust:2", b"x"),
+    ]
+    assert list(yottadb.nodes("testRange", reverse=True, limit=3)) == [(b"order:1", b"x"), (b"cust:3", b"x"), (b"cust:2", b"x")]
+    assert list(yottadb.nodes("^test4", limit=3)) == [(), (b"sub1",), (b"sub1", b"subsub1")]
+    assert list(yottadb.nodes("^test4", ("sub1",), reverse=True)) == [()]
+    assert list(yottadb.nodes("^test4", prefix=("sub3",), reverse=True, limit=2)) == [(b"sub3", b"subsub3"), (b"sub3", b"subsub2")]
+    yottadb.delete_tree("testRange")
+
+
 # Helper function that creates a node + value tuple that mirrors the
 # format used in SIMPLE_DATA to simplify output verification in
 # test_all_nodes_iter.
@@ -1607,6 +2136,51 @@ def test_tp_callback_multi(new_db):
     assert int(oranges.value) == int(oranges_init) + num_procs
 
 
+def test_Node_view(simple_data):
+    test4 = yottadb.Node("^test4")
+    view = test4.view()
+
+    assert len(view) == 3
+    assert list(view) == [b"sub1", b"sub2", b"sub3"]
+    assert "sub1" in view and b"sub2" in view
+    assert "nosub" not in view
+    assert view.value == b"test4"
+    # Child nodes with subtrees are views, and other child nodes are values
+    assert isinstance(view["sub1"], yottadb.NodeView)
+    assert view["sub1"].value == b"test4sub1"
+    assert view["sub1"]["subsub2"] == b"test4sub1subsub2"
+    assert dict(view["sub2"]) == {b"subsub1": b"test4sub2subsub1", b"subsub2": b"test4sub2subsub2", b"subsub3": b"test4sub2subsub3"}
+    with pytest.raises(KeyError):
+        view["nosub"]
+
+    # Writes go through to the database
+    view["sub1"]["subsub2"] = "new value"
+    assert test4["sub1"]["subsub2"].value == b"new value"
+    view["sub4"] = {"a": "1", "b": {"c": "2"}}
+    assert test4["sub4"]["a"].value == b"1"
+    assert test4["sub4"]["b"]["c"].value == b"2"
+    assert len(view) == 4
+    del view["sub1"]
+    assert test4["sub1"].data == yottadb.YDB_DATA_UNDEF
+    assert "sub1" not in view
+    with pytest.raises(KeyError):
+        del view["sub1"]
+    assert len(view) == 3
+
+    # Assigning a subtree view to itself preserves the whole subtree, including the value of its root node
+    test4["sub5"].value = "root"
+    test4["sub5"]["a"]["b"].value = "nested"
+    test4["sub5"]["c"].value = "leaf"
+    view["sub5"] = view["sub5"]
+    assert test4["sub5"].value == b"root"
+    assert test4["sub5"]["a"]["b"].value == b"nested"
+    assert test4["sub5"]["c"].value == b"leaf"
+    # Invalid values are rejected before the existing subtree is deleted
+    with pytest.raises(TypeError):
+        view["sub5"] = {"a": 1}
+    assert test4["sub5"]["c"].value == b"leaf"
+
+
 def test_Node_load_tree(simple_data):
     test4 = yottadb.Node("^test4")
     test4_dict = test4.load_tree()
@@ -21,9 +21,16 @@ __version__ = "2.0.1"
 __author__ = "YottaDB LLC"
 __credits__ = "Peter Goss"
 
-from typing import Optional, List, Union, Generator, AnyStr, Any, Callable, NewType, Tuple, Mapping
+from typing import Optional, List, Union, Generator, AnyStr, Any, Callable, NewType, Tuple, Mapping, Iterator
+from collections.abc import MutableMapping
 import copy
+import functools
+import itertools
+import multiprocessing
+import multiprocessing.pool
+import random
 import struct
+import threading
 from builtins import property
 import sys, os
 
@@ -38,45 +45,122 @@ from _yottadb import *
 # for use in type annotations
 Key = NewType("Key", object)
 Node = NewType("Node", object)
+NodeView = NewType("NodeView", object)
 SubscriptsIter = NewType("SubscriptsIter", object)
 NodesIter = NewType("NodesIter", object)
+WorkerPool = NewType("WorkerPool", object)
+Template = NewType("Template", object)
+AtomicBatch = NewType("AtomicBatch", object)
+GroupCommitter = NewType("GroupCommitter", object)
 
 # Get the maximum number of arguments accepted by ci()/cip()
 # based on whether the CPU architecture is 32-bit or 64-bit
 arch_bits = 8 * struct.calcsize("P")
 max_ci_args = 34 if 64 == arch_bits else 33
 
+# Operations supported by aggregate()
+aggregate_ops = ("count", "sum", "min", "max", "mean")
 
-# Get the YottaDB numeric error code for the given
-# YDBError by extracting it from the exception message.
-def get_error_code(YDBError):
-    if type(YDBError.args[0]) is bytes:
-        error_code = int(YDBError.args[0].split(b",")[0])  # Extract error code from between parentheses in error message
+# Maximum number of subscripts or nodes retrieved by each call to _yottadb.subscript_scan() or _yottadb.node_scan()
+# when iterating over a range of subscripts or nodes
+scan_chunk_size = 1024
+
+# Placeholder for a subscript of a template, which is given by a parameter on each access to the template
+PARAM = None
+
+
+class YDBErrorCode(int):
+    """
+    The YottaDB numeric error code stored on a `YDBException`. This is an `int`, but is also callable
+    and returns itself when called, so that code written when `code` was a method, i.e. `e.code()`,
+    continues to work.
+    """
+
+    def __call__(self) -> int:
+        return int(self)
+
+
+# Error codes for exceptions that may be raised without an error code argument, e.g. `raise YDBTPRestart`
+# from a transaction callback, or by the C extension with a custom message, e.g. YDBLockTimeoutError.
+_default_error_codes = {
+    YDBTPRollback: YDB_TP_ROLLBACK,
+    YDBTPRestart: YDB_TP_RESTART,
+    YDBNotOk: YDB_NOTOK,
+    YDBLockTimeoutError: YDB_LOCK_TIMEOUT,
+    YDBTPTimeoutError: YDB_ERR_TPTIMEOUT,
+    YDBDeferHandler: YDB_DEFER_HANDLER,
+    YDBNodeEnd: YDB_ERR_NODEEND,
+}
+
+
+def get_error_code(exception: YDBException) -> Optional[YDBErrorCode]:
+    """
+    Get the YottaDB numeric error code for the given exception. The C extension raises exceptions
+    with the error code as the last argument, so no parsing of the error message is needed.
+
+    A `YDBError` has the $ZSTATUS message as its first argument and the error code as its second. Exceptions
+    that have no $ZSTATUS message, e.g. `YDBNodeEnd`, `YDBTPRestart` or `YDBLockTimeoutError`, have the error
+    code as their only argument, so their `args[0]` is an int rather than a message string.
+
+    :param exception: A `YDBException` object.
+    :returns: A `YDBErrorCode` object, or None if the exception has no associated YottaDB error code.
+    """
+    if exception.args and isinstance(exception.args[-1], int):
+        return YDBErrorCode(exception.args[-1])
+    error_code = _default_error_codes.get(type(exception))
+    if error_code is None:
+        return None
+    return YDBErrorCode(error_code)
+
+
+def get_error_message(exception: YDBException) -> str:
+    """
+    Get the error message for the given exception. The message of a `YDBError` is its $ZSTATUS, captured when it
+    was raised. The message of the other exceptions is only looked up when it is first needed, e.g. when `str()`
+    is called on the exception, and is then cached on the exception object.
+
+    :param exception: A `YDBException` object.
+    :returns: A string containing the error message.
+    """
+    try:
+        return exception._message
+    except AttributeError:
+        pass
+
+    args = exception.args
+    if 2 == len(args) and isinstance(args[0], (str, bytes)) and isinstance(args[1], int):
+        # $ZSTATUS captured when the error was raised
+        error_message = args[0]
+        if isinstance(error_message, bytes):
+            error_message = error_message.decode(errors="backslashreplace")
+        exception._message = error_message
+        return error_message
+    if 1 != len(args) or not isinstance(args[0], int):
+        # Raised with a custom message, or no message at all
+        return Exception.__str__(exception)
+    error_code = args[0]
+    if YDB_TP_ROLLBACK == error_code:
+        error_message = f"{error_code}, %YDB-TP-ROLLBACK: Transaction not committed."
+    elif YDB_TP_RESTART == error_code:
+        error_message = f"{error_code}, %YDB-TP-RESTART: Restarting transaction."
+    elif YDB_NOTOK == error_code or YDB_DEFER_HANDLER == error_code:
+        # No valid error message exists for these codes, so just use the error code number
+        error_message = str(error_code)
+    elif YDB_ERR_TPTIMEOUT == error_code or YDB_ERR_NODEEND == error_code or YDB_LOCK_TIMEOUT == error_code:
+        # These errors do not have a value stored in $ZSTATUS, so look up the error message manually
+        error_message = f"{error_code}, {_yottadb.message(error_code)}"
     else:
-        error_code = int(YDBError.args[0].split(",")[0])  # Extract error code from between parentheses in error message
-    if 0 < error_code:
-        error_code *= -1  # Multiply by -1 for conformity with negative YDB error codes
-    return error_code
-
-
-# Note that the following setattr() call is done due to how the PyErr_SetObject()
-# Python C API function works. That is, this function calls the constructor of a
-# specified Exception type, in this case YDBError, and sets Python's
-# internal error indicator causing the exception mechanism to fire and
-# raise an exception visible at the Python level. Since both of these things
-# are done by this single function, there is no opportunity for the calling
-# C code to modify the created YDBError object instance and append the YDB
-# error code.
-#
-# Moreover, it is not straightforward (and perhaps not possible) to define
-# a custom constructor for custom exceptions defined in C code, e.g. YDBError.
-# Such might allow for an error code integer to be set on the YDBError object
-# when it is created by PyErr_SetObject() without the need for returning control
-# to the calling C code to update the object.
-#
-# Attach error code lookup function to the YDBError class
-# as a method for convenience.
-setattr(YDBError, "code", get_error_code)
+        # $ZSTATUS could not be read when the error was raised, so only the message text for the error code is known
+        error_message = f"{-error_code},(SimpleAPI),{_yottadb.message(error_code)}"
+    exception._message = error_message
+    return error_message
+
+
+# The C extension creates YottaDB exceptions with PyErr_NewException(), which does not provide a way to
+# define custom attributes or methods. So, attach the error code and lazy error message lookup to the base
+# class of all YottaDB exceptions here.
+YDBException.code = property(get_error_code)
+YDBException.__str__ = get_error_message
 
 
 def adjust_stdout_stderr() -> None:
@@ -93,24 +177,85 @@ def adjust_stdout_stderr() -> None:
     return _yottadb.adjust_stdout_stderr()
 
 
-def get(name: AnyStr, subsarray: Tuple[AnyStr] = ()) -> Optional[bytes]:
+def child_init() -> None:
+    """
+    Reinitialize YottaDB in a child process created by `fork()`, so that the child process does not share database
+    resources, such as journal buffers, with its parent process. This is called automatically in child processes created
+    by `os.fork()`, including by the `multiprocessing` module with the "fork" start method, so it only needs to be called
+    explicitly in child processes created by other means, e.g. by a C extension calling `fork()` directly.
+
+    :returns: None
+    """
+    return _yottadb.child_init()
+
+
+# Reinitialize YottaDB in every child process forked by Python, before it runs any other code
+os.register_at_fork(after_in_child=child_init)
+
+
+def utf8_cache_stats(reset: bool = False) -> dict:
+    """
+    Report how many `str` variable names, subscripts and values were converted for YottaDB without any encoding work
+    (hits), and how many may have had to be encoded first (potential misses). ASCII strings, which are their own UTF-8
+    encoding, are hits. Other strings are potential misses, although Python caches their encoding in each `str` object,
+    so that recurring strings, e.g. subscripts stored in constants, or interned by Python, are only encoded once.
+
+    :param reset: Whether to reset the counts to zero after reporting them.
+    :returns: A dictionary of the form `{"hits": hits, "misses": misses}`.
+    """
+    return _yottadb.utf8_cache_stats(reset)
+
+
+def get(name: AnyStr, subsarray: Tuple[AnyStr] = (), decode: str = None, errors: str = "strict") -> Optional[AnyStr]:
     """
     Retrieve the value of the local or global variable node specified by the `name` and `subsarray` pair.
+    If `decode` is given, the value is decoded into a str object in C, which is faster than calling `.decode()` on it.
 
     :param name: A bytes-like object representing a YottaDB local or global variable name.
     :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
-    :returns: If the specified node has a value, returns it as a bytes object. If not, returns None.
+    :param decode: The encoding with which to decode the result into str objects, e.g. "utf-8", or None for bytes objects.
+    :param errors: The error handler for decoding, e.g. "strict", "replace" or "surrogateescape".
+    :returns: If the specified node has a value, returns it as a bytes object, or a str object if `decode` is given.
+        If not, returns None.
     """
     try:
-        return _yottadb.get(name, subsarray)
+        return _yottadb.get(name, subsarray, decode, errors)
     except YDBError as e:
-        ecode = e.code()
+        ecode = e.code
         if _yottadb.YDB_ERR_LVUNDEF == ecode or _yottadb.YDB_ERR_GVUNDEF == ecode:
             return None
         else:
             raise e
 
 
+def get_int(name: AnyStr, subsarray: Tuple[AnyStr] = ()) -> Optional[int]:
+    """
+    Retrieve the value of the local or global variable node specified by the `name` and `subsarray` pair
+    as a Python `int`. The conversion is done in C directly from the YottaDB canonical number, which is
+    faster than calling `int(get(name, subsarray))`.
+
+    :param name: A bytes-like object representing a YottaDB local or global variable name.
+    :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
+    :returns: If the specified node has a value, returns it as an int. If not, returns None.
+    :raises ValueError: If the value of the node is not an integer.
+    """
+    return _yottadb.get_int(name, subsarray)
+
+
+def get_float(name: AnyStr, subsarray: Tuple[AnyStr] = ()) -> Optional[float]:
+    """
+    Retrieve the value of the local or global variable node specified by the `name` and `subsarray` pair
+    as a Python `float`. The conversion is done in C directly from the YottaDB canonical number, which is
+    faster than calling `float(get(name, subsarray))`.
+
+    :param name: A bytes-like object representing a YottaDB local or global variable name.
+    :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
+    :returns: If the specified node has a value, returns it as a float. If not, returns None.
+    :raises ValueError: If the value of the node is not numeric.
+    """
+    return _yottadb.get_float(name, subsarray)
+
+
 def set(name: AnyStr, subsarray: Tuple[AnyStr] = (), value: AnyStr = "") -> None:
     """
     Set the local or global variable node specified by the `name` and `subsarray` pair.
@@ -236,6 +381,19 @@ def data(name: AnyStr, subsarray: Tuple[AnyStr] = ()) -> int:
     return _yottadb.data(name, subsarray)
 
 
+def fetch(name: AnyStr, subsarray: Tuple[AnyStr] = ()) -> Tuple[int, Optional[bytes]]:
+    """
+    Get both the data status and the value of the local or global variable node specified by the `name`
+    and `subsarray` pair in a single call, instead of calling `data()` and `get()` separately.
+
+    :param name: A bytes-like object representing a YottaDB local or global variable name.
+    :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
+    :returns: A tuple of the form `(data_status, value)`, where `data_status` is 0, 1, 10, or 11 as returned by `data()`,
+        and `value` is the value of the node as a bytes object, or None if the node has no value.
+    """
+    return _yottadb.fetch(name, subsarray)
+
+
 def delete_node(name: AnyStr, subsarray: Tuple[AnyStr] = ()) -> None:
     """
     Deletes the value at the local or global variable node specified by the `name` and `subsarray` pair.
@@ -296,52 +454,535 @@ def incr(name: AnyStr, subsarray: Tuple[AnyStr] = (), increment: Union[int, floa
     return _yottadb.incr(name, subsarray, increment)
 
 
-def subscript_next(name: AnyStr, subsarray: Tuple[AnyStr] = ()) -> bytes:
+def incr_int(name: AnyStr, subsarray: Tuple[AnyStr] = (), increment: int = 1) -> Union[int, float]:
+    """
+    Increments the value of the local or global variable node specified by the `name` and `subsarray` pair
+    by the integer amount specified by `increment`, and returns the new value as a Python number. Unlike
+    `incr()`, no conversion of the increment to a string or of the result from a bytes object is needed.
+
+    :param name: A bytes-like object representing a YottaDB local or global variable name.
+    :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
+    :param increment: An int specifying the amount by which to increment the given node.
+    :returns: The new value of the node as an int, or as a float if the node previously held a non-integer value.
+    """
+    return _yottadb.incr_int(name, subsarray, increment)
+
+
+def subscript_next(name: AnyStr, subsarray: Tuple[AnyStr] = (), decode: str = None, errors: str = "strict") -> AnyStr:
     """
     Retrieves the next subscript at the given subscript level of the local or global variable node
     specified by the `name` and `subsarray` pair.
 
     :param name: A bytes-like object representing a YottaDB local or global variable name.
     :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
-    :returns: The next subscript at the given subscript level as a bytes object.
+    :param decode: The encoding with which to decode the result into str objects, e.g. "utf-8", or None for bytes objects.
+    :param errors: The error handler for decoding, e.g. "strict", "replace" or "surrogateescape".
+    :returns: The next subscript at the given subscript level as a bytes object, or a str object if `decode` is given.
     """
-    return _yottadb.subscript_next(name, subsarray)
+    return _yottadb.subscript_next(name, subsarray, decode=decode, errors=errors)
 
 
-def subscript_previous(name: AnyStr, subsarray: Tuple[AnyStr] = ()) -> bytes:
+def subscript_previous(name: AnyStr, subsarray: Tuple[AnyStr] = (), decode: str = None, errors: str = "strict") -> AnyStr:
     """
     Retrieves the previous subscript at the given subscript level of the local or global variable node
     specified by the `name` and `subsarray` pair.
 
     :param name: A bytes-like object representing a YottaDB local or global variable name.
     :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
-    :returns: The previous subscript at the given subscript level as a bytes object.
+    :param decode: The encoding with which to decode the result into str objects, e.g. "utf-8", or None for bytes objects.
+    :param errors: The error handler for decoding, e.g. "strict", "replace" or "surrogateescape".
+    :returns: The previous subscript at the given subscript level as a bytes object, or a str object if `decode` is given.
     """
-    return _yottadb.subscript_previous(name, subsarray)
+    return _yottadb.subscript_previous(name, subsarray, decode=decode, errors=errors)
 
 
-def node_next(name: AnyStr, subsarray: Tuple[AnyStr] = ()) -> Tuple[bytes, ...]:
+def subscript_count(name: AnyStr, subsarray: Tuple[AnyStr] = ()) -> int:
+    """
+    Count the child subscripts of the local or global variable node specified by the `name` and `subsarray` pair.
+    The subscripts are iterated over in C, so no Python objects are created for them.
+
+    :param name: A bytes-like object representing a YottaDB local or global variable name.
+    :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
+    :returns: The number of child subscripts of the specified node.
+    """
+    return _yottadb.subscript_count(name, subsarray)
+
+
+def items(
+    name: AnyStr, subsarray: Tuple[AnyStr] = (), data: bool = False, decode: str = None, errors: str = "strict"
+) -> Generator:
+    """
+    A Generator that yields a `(subscript, value)` tuple for each child subscript of the local or global variable node
+    specified by the `name` and `subsarray` pair, instead of calling `get()` for each subscript yielded by `subscripts()`.
+    The subscripts and values are retrieved by `_yottadb.items()` in chunks of at most `scan_chunk_size` children.
+
+    If `decode` is given, the values are decoded by `_yottadb.items()` in C, and the subscripts, which are retrieved as
+    bytes objects so that each chunk resumes exactly after the previous one, are decoded as they are yielded.
+
+    :param name: A bytes-like object representing a YottaDB local or global variable name.
+    :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
+    :param data: Whether to also yield the data status of each child, as returned by `data()`.
+    :param decode: The encoding with which to decode the subscripts and values into str objects, e.g. "utf-8", or None for
+        bytes objects.
+    :param errors: The error handler for decoding, e.g. "strict", "replace" or "surrogateescape".
+    :returns: A tuple of the form `(subscript, value)`, or `(subscript, value, data_status)` if `data` is set, where
+        `value` is a bytes object, or a str object if `decode` is given, or None if the child node has no value.
+    """
+    child_subsarray = list(subsarray) + [""]
+    while True:
+        chunk = _yottadb.items(name, child_subsarray, scan_chunk_size, data, decode, errors)
+        if decode is None:
+            yield from chunk
+        else:
+            for item in chunk:
+                yield (item[0].decode(decode, errors),) + item[1:]
+        if len(chunk) < scan_chunk_size:
+            return
+        # Resume after the last subscript retrieved
+        child_subsarray[-1] = chunk[-1][0]
+
+
+def walk(
+    name: AnyStr,
+    subsarray: Tuple[AnyStr] = (),
+    max_depth: int = None,
+    relative: bool = False,
+    decode: str = None,
+    errors: str = "strict",
+) -> Generator:
+    """
+    A Generator that yields a `(subsarray, value)` tuple for each node with a value in the subtree of the local or global
+    variable node specified by the `name` and `subsarray` pair, including the node itself, in depth-first order. This
+    avoids calling `get()` for each node yielded by `nodes()`. The nodes are traversed by `_yottadb.walk()`, which returns
+    them in chunks of at most `scan_chunk_size` nodes.
+
+    If `decode` is given, the values are decoded by `_yottadb.walk()` in C, and the subscripts, which are retrieved as
+    bytes objects so that each chunk resumes exactly after the previous one, are decoded as they are yielded.
+
+    :param name: A bytes-like object representing a YottaDB local or global variable name.
+    :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
+    :param max_depth: The maximum number of levels below the specified node to traverse, or None for no limit.
+    :param relative: Whether to yield subscript arrays relative to the specified node rather than to the variable.
+    :param decode: The encoding with which to decode the subscripts and values into str objects, e.g. "utf-8", or None for
+        bytes objects.
+    :param errors: The error handler for decoding, e.g. "strict", "replace" or "surrogateescape".
+    :returns: A tuple of the form `(subsarray, value)`, where `subsarray` is a tuple of bytes objects and `value` is
+        a bytes object, or str objects if `decode` is given.
+    """
+    if max_depth is not None and 0 > max_depth:
+        raise ValueError(f"'max_depth' must be non-negative, not {max_depth}")
+    cursor = None
+    while True:
+        chunk = _yottadb.walk(
+            name, subsarray, cursor, scan_chunk_size, -1 if max_depth is None else max_depth, relative, decode, errors
+        )
+        if decode is None:
+            yield from chunk
+        else:
+            for node, value in chunk:
+                yield tuple(sub.decode(decode, errors) for sub in node), value
+        if len(chunk) < scan_chunk_size:
+            return
+        # Resume after the last node retrieved
+        cursor = tuple(subsarray) + chunk[-1][0] if relative else chunk[-1][0]
+
+
+def merge(
+    src: Union[Node, Key, Tuple[AnyStr, Tuple[AnyStr]]],
+    dst: Union[Node, Key, Tuple[AnyStr, Tuple[AnyStr]]],
+    overwrite: bool = True,
+    chunk_size: int = None,
+) -> int:
+    """
+    Copy the value of each node in the subtree of the local or global variable node `src`, including `src` itself, to the
+    corresponding node in the subtree of `dst`, as with the M MERGE command. The nodes are copied by `_yottadb.merge()`
+    without creating Python objects for their subscripts or values.
+
+    If `chunk_size` is specified, the nodes are copied in separate transactions of at most `chunk_size` source nodes each,
+    so that large subtrees can be copied without a single large transaction. Otherwise, no transaction is used.
+
+    :param src: A `Node` or `Key` object, or a tuple of a variable name and a subscript array, representing the node to copy.
+    :param dst: A `Node` or `Key` object, or a tuple of a variable name and a subscript array, representing the node to copy to.
+    :param overwrite: Whether to replace the values of destination nodes that already have a value.
+    :param chunk_size: The maximum number of source nodes to copy in each transaction.
+    :returns: The number of destination nodes set.
+    """
+    src_name, src_subsarray = (src.name, src.subsarray) if isinstance(src, Node) or isinstance(src, Key) else src
+    dst_name, dst_subsarray = (dst.name, dst.subsarray) if isinstance(dst, Node) or isinstance(dst, Key) else dst
+    if chunk_size is None:
+        copied, _ = _yottadb.merge(src_name, src_subsarray, dst_name, dst_subsarray, overwrite)
+        return copied
+    if 0 >= chunk_size:
+        raise ValueError(f"'chunk_size' must be positive, not {chunk_size}")
+
+    total = 0
+    cursor = None
+    result = []
+
+    def merge_chunk() -> int:
+        # Overwrite the result of any previous attempt if the transaction is restarted
+        result[:] = _yottadb.merge(src_name, src_subsarray, dst_name, dst_subsarray, overwrite, cursor, chunk_size)
+        return YDB_OK
+
+    while True:
+        tp(merge_chunk)
+        copied, cursor = result
+        total += copied
+        if cursor is None:
+            return total
+
+
+def diff(
+    a: Union[Node, Key, Tuple[AnyStr, Tuple[AnyStr]]],
+    b: Union[Node, Key, Tuple[AnyStr, Tuple[AnyStr]]],
+) -> Generator:
+    """
+    A Generator that yields a `(subsarray, kind, a_value, b_value)` tuple for each difference between the subtrees of the
+    local or global variable nodes `a` and `b`, including the nodes themselves, in collation order. The subtrees are
+    traversed together by `_yottadb.diff()` as a merge join, which returns the differences in chunks of at most
+    `scan_chunk_size`, so that neither subtree is held in memory.
+
+    :param a: A `Node` or `Key` object, or a tuple of a variable name and a subscript array, representing the original node.
+    :param b: A `Node` or `Key` object, or a tuple of a variable name and a subscript array, representing the node to compare.
+    :returns: A tuple of the form `(subsarray, kind, a_value, b_value)`, where `subsarray` is a tuple of bytes objects
+        relative to `a` and `b`, `kind` is "added" for a node with a value only under `b`, "removed" for a node with a value
+        only under `a`, or "changed" for a node with different values under each, and `a_value` and `b_value` are the
+        bytes values of the node under `a` and `b`, or None if it has no value there.
+    """
+    a_name, a_subsarray = (a.name, a.subsarray) if isinstance(a, Node) or isinstance(a, Key) else a
+    b_name, b_subsarray = (b.name, b.subsarray) if isinstance(b, Node) or isinstance(b, Key) else b
+    cursor = None
+    while True:
+        chunk, cursor = _yottadb.diff(a_name, a_subsarray, b_name, b_subsarray, cursor, scan_chunk_size)
+        yield from chunk
+        if cursor is None:
+            return
+
+
+def merged_nodes(nodes: List[Union[Node, Key, Tuple[AnyStr, Tuple[AnyStr]]]]) -> Generator:
+    """
+    A Generator that yields a `(source_index, subsarray, value)` tuple for each node with a value in the subtrees of all of
+    the given local or global variable nodes, including the nodes themselves, merged into a single collation order by their
+    subscripts relative to the given nodes. This allows data split across several variables or subtrees, e.g. `^orders1`
+    to `^ordersN`, to be read in key order without sorting it. The subtrees are traversed together by
+    `_yottadb.merged_nodes()`, which holds only the current node of each subtree and returns the nodes in chunks of at most
+    `scan_chunk_size`.
+
+    :param nodes: A list of `Node` or `Key` objects, or tuples of a variable name and a subscript array, representing the
+        nodes to merge.
+    :returns: A tuple of the form `(source_index, subsarray, value)`, where `source_index` is the index in `nodes` of the
+        node whose subtree contains the yielded node, `subsarray` is a tuple of bytes objects relative to that node, and
+        `value` is a bytes object. Nodes with the same relative subscripts in several subtrees are yielded in the order of
+        `nodes`.
+    """
+    sources = [(node.name, node.subsarray) if isinstance(node, Node) or isinstance(node, Key) else node for node in nodes]
+    cursor = None
+    while True:
+        chunk = _yottadb.merged_nodes(sources, cursor, scan_chunk_size)
+        yield from chunk
+        if len(chunk) < scan_chunk_size:
+            return
+        # Resume after the last node retrieved
+        cursor = chunk[-1][:2]
+
+
+def subtree_stats(name: AnyStr, subsarray: Tuple[AnyStr] = (), sample_rate: float = 1.0, seed: int = None) -> dict:
+    """
+    Compute statistics for the subtree of the local or global variable node specified by the `name` and `subsarray` pair,
+    including the node itself. The subtree is traversed by `_yottadb.subtree_stats()`, without creating Python objects for
+    its subscripts or values. The result is a dictionary with the following keys:
+
+    - "nodes": The number of nodes with a value.
+    - "value_bytes": The total size of the values, in bytes.
+    - "max_depth": The maximum depth of a node with a value, relative to the specified node.
+    - "value_sizes": A histogram of value sizes, mapping the upper bound of each power of two bucket to a number of values.
+    - "fanout": A list of histograms of the number of children of the nodes at each depth, relative to the specified node.
+    - "sample_rate": The sample rate used.
+
+    If `sample_rate` is less than 1, each child subtree of the specified node is traversed with that probability,
+    so that statistics for large subtrees can be estimated cheaply by dividing the counts by the sample rate.
+    Only the number of children of the specified node itself includes the children that were not sampled.
+
+    :param name: A bytes-like object representing a YottaDB local or global variable name.
+    :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
+    :param sample_rate: The fraction of the child subtrees of the specified node to traverse, greater than 0 and at most 1.
+    :param seed: An optional seed for the selection of the child subtrees to sample, for reproducible results.
+    :returns: A dictionary of statistics.
+    """
+    if seed is None:
+        seed = random.getrandbits(64)
+    return _yottadb.subtree_stats(name, subsarray, sample_rate, seed)
+
+
+def aggregate(
+    name: AnyStr,
+    subsarray: Tuple[AnyStr] = (),
+    ops: Tuple[str] = ("sum", "count", "min", "max"),
+    depth: int = None,
+    group_by: int = None,
+) -> dict:
+    """
+    Aggregate the values of the nodes in the subtree of the local or global variable node specified by the `name` and
+    `subsarray` pair, including the node itself, that are canonical numbers. Values that are not canonical numbers are
+    ignored. The subtree is traversed and the values are converted to numbers by `_yottadb.aggregate()`, without creating
+    Python objects for each node.
+
+    The sum, min, and max are integers if all values are integers whose sum fits in a 64-bit integer, and floats otherwise.
+    The min, max, and mean are None if there are no numeric values.
+
+    :param name: A bytes-like object representing a YottaDB local or global variable name.
+    :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
+    :param ops: The operations to compute, any of "count", "sum", "min", "max", and "mean".
+    :param depth: If specified, only aggregate the nodes this many levels below the specified node. The subtrees below
+        that level are skipped rather than traversed.
+    :param group_by: If specified, aggregate the nodes separately for each subscript this many levels below the specified
+        node, e.g. 1 for each child of the specified node.
+    :returns: A dictionary mapping each operation to its result, or if `group_by` is specified, a dictionary mapping each
+        subscript at the `group_by` level to such a dictionary.
+    """
+    for op in ops:
+        if op not in aggregate_ops:
+            raise ValueError(f"unsupported aggregate operation {op!r}: must be one of {aggregate_ops}")
+    if depth is not None and 0 > depth:
+        raise ValueError(f"'depth' must be non-negative, not {depth}")
+    if group_by is not None and 0 >= group_by:
+        raise ValueError(f"'group_by' must be positive, not {group_by}")
+
+    def select(totals: Tuple[int, Union[int, float], Union[int, float, None], Union[int, float, None]]) -> dict:
+        count, total, minimum, maximum = totals
+        results = {"count": count, "sum": total, "min": minimum, "max": maximum, "mean": total / count if count else None}
+        return {op: results[op] for op in ops}
+
+    totals = _yottadb.aggregate(name, subsarray, -1 if depth is None else depth, 0 if group_by is None else group_by)
+    if group_by is None:
+        return select(totals)
+    return {group: select(group_totals) for group, group_totals in totals.items()}
+
+
+def parallel_scan_ranges(name: AnyStr, subsarray: Tuple[AnyStr], parts: int) -> List[Tuple[Optional[bytes], Optional[bytes]]]:
+    """
+    Partition the child subscripts of the local or global variable node specified by the `name` and `subsarray` pair into
+    at most `parts` contiguous ranges of nearly equal numbers of subscripts, for `parallel_scan()`. The subscripts are
+    counted by `_yottadb.subscript_count()`, and the split points are then found by a single pass over the subscripts.
+
+    :returns: A list of `(start, stop)` tuples, where `start` is the first subscript of a range, or None for the first range,
+        and `stop` is the first subscript of the next range, or None for the last range.
+    """
+    total = _yottadb.subscript_count(name, subsarray)
+    children = scan_subscripts(name, tuple(subsarray) + ("",), None, None, None, None, False)
+    bounds = [None]
+    position = 0
+    for part in range(1, min(parts, total)):
+        target = part * total // parts
+        split = next(itertools.islice(children, target - position, None), None)
+        if split is None:
+            # Subscripts were deleted since they were counted
+            break
+        bounds.append(split)
+        position = target + 1
+    bounds.append(None)
+    return list(zip(bounds, bounds[1:]))
+
+
+def parallel_scan_worker(
+    name: AnyStr,
+    subsarray: Tuple[AnyStr],
+    start: Optional[bytes],
+    stop: Optional[bytes],
+    func: Callable[[Node], Any],
+    reduce: Optional[Callable[[Any, Any], Any]],
+    connection: "multiprocessing.connection.Connection",
+) -> None:
+    """
+    Apply `func` to each child node of the node specified by the `name` and `subsarray` pair whose subscript is within the
+    range from `start` (inclusive) to `stop` (exclusive), in a worker process started by `parallel_scan()`, and send a list
+    of the results, or of their reduction with `reduce`, or the exception raised, to the parent process over `connection`.
+    """
+    try:
+        children = scan_subscripts(name, tuple(subsarray) + ("",), start, stop, None, None, False)
+        results = (func(Node(name, tuple(subsarray) + (subscript,))) for subscript in children)
+        if reduce is None:
+            partial = list(results)
+        else:
+            partial = list(itertools.islice(results, 1))
+            if partial:
+                partial = [functools.reduce(reduce, results, partial[0])]
+        connection.send((partial, None))
+    except BaseException as exception:
+        connection.send((None, exception))
+    finally:
+        connection.close()
+
+
+# Default value of the `initial` argument of parallel_scan(), so that None may be passed as an initial value
+_NO_INITIAL = object()
+
+
+def parallel_scan(
+    node: Union[Node, Key, Tuple[AnyStr, Tuple[AnyStr]]],
+    func: Callable[[Node], Any],
+    reduce: Callable[[Any, Any], Any] = None,
+    initial: Any = _NO_INITIAL,
+    workers: int = None,
+) -> Any:
+    """
+    Apply `func` to each child node of the local or global variable node `node` in parallel across worker processes, and
+    optionally reduce the results. The child subscripts are partitioned into one contiguous range per worker by
+    `parallel_scan_ranges()`, and each range is handled by a process forked with the `multiprocessing` module. If `reduce`
+    is specified, each worker reduces the results for its range, and the partial results of the workers are then reduced
+    in subscript order, so `reduce` must be associative.
+
+    `func` and `reduce` are inherited by the worker processes rather than pickled, so they may be lambdas or closures, but the
+    results of `func` must be picklable. This function must not be called inside a transaction.
+
+    :param node: A `Node` or `Key` object, or a tuple of a variable name and a subscript array, representing the node whose
+        child nodes are to be processed.
+    :param func: A function called with a `Node` object for each child node, in a worker process.
+    :param reduce: An optional function of two results that combines them into one, as with `functools.reduce()`.
+    :param initial: If `reduce` is specified, a value combined with the results first, and returned if there are no
+        child nodes. If it is not specified, None is returned if there are no child nodes.
+    :param workers: The number of worker processes, by default the number of CPUs available to the process.
+    :returns: A list of the results of `func` in subscript order, or their reduction if `reduce` is specified.
+    """
+    name, subsarray = (node.name, node.subsarray) if isinstance(node, Node) or isinstance(node, Key) else node
+    if workers is None:
+        workers = len(os.sched_getaffinity(0))
+    if 0 >= workers:
+        raise ValueError(f"'workers' must be positive, not {workers}")
+
+    # Fork the workers, so that they inherit func and reduce, and YottaDB is reinitialized by child_init()
+    context = multiprocessing.get_context("fork")
+    processes = []
+    for start, stop in parallel_scan_ranges(name, subsarray, workers):
+        receiver, sender = context.Pipe(duplex=False)
+        process = context.Process(target=parallel_scan_worker, args=(name, subsarray, start, stop, func, reduce, sender))
+        process.start()
+        sender.close()
+        processes.append((process, receiver))
+
+    partials = []
+    error = None
+    for process, receiver in processes:
+        try:
+            partial, exception = receiver.recv()
+        except EOFError:
+            partial, exception = None, ChildProcessError("parallel_scan() worker process exited without a result")
+        receiver.close()
+        process.join()
+        if error is None and exception is not None:
+            error = exception
+        elif partial:
+            partials.extend(partial)
+    if error is not None:
+        raise error
+
+    if reduce is None:
+        return partials
+    if initial is not _NO_INITIAL:
+        partials.insert(0, initial)
+    return functools.reduce(reduce, partials) if partials else None
+
+
+class WorkerPool(multiprocessing.pool.Pool):
+    """
+    A `multiprocessing.pool.Pool` whose worker processes are forked from the current process after its YottaDB runtime
+    has been initialized, and optionally after a call-in table has been opened and other setup has been done by a `warmup`
+    function. Each worker process, including any worker started to replace one that exited, inherits the initialized
+    runtime and state of the parent process, so tasks do not pay the startup cost of YottaDB in each process. YottaDB is
+    reinitialized in each worker by `child_init()` when it is forked.
+
+    The call-in table given by `ci_table` is only active in the current process while `warmup` runs, and in the worker
+    processes, so the active call-in table of the current process is unchanged once the `WorkerPool` is created.
+
+    Unlike a `multiprocessing.pool.Pool`, exiting a `WorkerPool` used as a context manager waits for outstanding tasks to
+    complete, rather than terminating the workers, so that no worker is stopped in the middle of a database update.
+    """
+
+    def __init__(
+        self,
+        processes: int = None,
+        initializer: Callable = None,
+        initargs: tuple = (),
+        maxtasksperchild: int = None,
+        ci_table: AnyStr = None,
+        warmup: Callable[[], Any] = None,
+    ):
+        """
+        Initialize the YottaDB runtime of the current process and start the worker processes.
+
+        :param processes: The number of worker processes, by default the number of CPUs.
+        :param initializer: An optional function called in each worker process when it starts, with `initargs`.
+        :param initargs: The arguments for `initializer`.
+        :param maxtasksperchild: An optional number of tasks after which each worker process is replaced.
+        :param ci_table: The name of a YottaDB call-in table to open and make active while `warmup` runs and in the
+            worker processes.
+        :param warmup: An optional function called once in the current process before starting the workers, e.g. to
+            populate local variables or call M routines that the tasks use.
+        :returns: A `WorkerPool` object.
+        """
+        # Looking up the release initializes the YottaDB runtime, if it is not already initialized
+        _yottadb.release()
+        handle = None
+        if ci_table is not None:
+            handle = open_ci_table(ci_table)
+            previous = switch_ci_table(handle)
+        try:
+            if warmup is not None:
+                warmup()
+        finally:
+            if handle is not None:
+                # A previous handle of None represents the default call-in table
+                switch_ci_table(0 if previous is None else previous)
+        super().__init__(
+            processes,
+            WorkerPool._initialize_worker,
+            (handle, initializer, initargs),
+            maxtasksperchild,
+            multiprocessing.get_context("fork"),
+        )
+
+    @staticmethod
+    def _initialize_worker(handle: Optional[int], initializer: Optional[Callable], initargs: tuple) -> None:
+        # Activate the call-in table of the pool, which remains open in each forked worker process
+        if handle is not None:
+            switch_ci_table(handle)
+        if initializer is not None:
+            initializer(*initargs)
+
+    def __exit__(self, exc_type, exc_value, traceback) -> None:
+        self.close()
+        self.join()
+
+
+def node_next(name: AnyStr, subsarray: Tuple[AnyStr] = (), decode: str = None, errors: str = "strict") -> Tuple[AnyStr, ...]:
     """
     Retrieves the next node from the local or global variable node specified by the `name`
     and `subsarray` pair.
 
     :param name: A bytes-like object representing a YottaDB local or global variable name.
     :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
-    :returns: A subscript array representing the next node as a tuple of bytes objects.
+    :param decode: The encoding with which to decode the result into str objects, e.g. "utf-8", or None for bytes objects.
+    :param errors: The error handler for decoding, e.g. "strict", "replace" or "surrogateescape".
+    :returns: A subscript array representing the next node as a tuple of bytes objects, or str objects if `decode` is given.
     """
-    return _yottadb.node_next(name, subsarray)
+    return _yottadb.node_next(name, subsarray, decode=decode, errors=errors)
 
 
-def node_previous(name: AnyStr, subsarray: Tuple[AnyStr] = ()) -> Tuple[bytes, ...]:
+def node_previous(
+    name: AnyStr, subsarray: Tuple[AnyStr] = (), decode: str = None, errors: str = "strict"
+) -> Tuple[AnyStr, ...]:
     """
     Retrieves the previous node from the local or global variable node specified by the `name`
     and `subsarray` pair.
 
     :param name: A bytes-like object representing a YottaDB local or global variable name.
     :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
-    :returns: A subscript array representing the previous node as a tuple of bytes objects.
+    :param decode: The encoding with which to decode the result into str objects, e.g. "utf-8", or None for bytes objects.
+    :param errors: The error handler for decoding, e.g. "strict", "replace" or "surrogateescape".
+    :returns: A subscript array representing the previous node as a tuple of bytes objects, or str objects if `decode`
+        is given.
     """
-    return _yottadb.node_previous(name, subsarray)
+    return _yottadb.node_previous(name, subsarray, decode=decode, errors=errors)
 
 
 def lock_incr(name: AnyStr, subsarray: Tuple[AnyStr] = (), timeout_nsec: int = 0) -> None:
@@ -419,6 +1060,377 @@ def tp(callback: object, args: tuple = None, transid: str = "", names: Tuple[Any
     return _yottadb.tp(callback, args, kwargs, transid, names)
 
 
+def atomic(ops: List[Tuple], transid: str = "", names: Tuple[AnyStr] = None) -> Optional[List]:
+    """
+    Executes the operations in `ops` in order in a single YottaDB transaction, without calling back into Python, so that
+    neither the transaction nor any of its restarts run Python code. Each operation is a tuple of an operation name, a
+    YottaDB local or global variable name, a subscript array, and the arguments of the operation. The variable name and
+    subscript array may be replaced by a `Node` or `Key` object. The operations and their results are:
+
+        ("get", name, subsarray)                              -> the value of the node, or None if it has no value
+        ("set", name, subsarray, value)                       -> None
+        ("incr", name, subsarray, increment)                  -> the new value of the node
+        ("delete", name, subsarray)                           -> None
+        ("delete_tree", name, subsarray)                      -> None
+        ("data", name, subsarray)                             -> the result of `data()` for the node
+        ("compare_and_set", name, subsarray, expected, new)   -> None
+
+    A `compare_and_set` operation sets the node to `new`, or deletes it if `new` is None, only if its value is `expected`,
+    or if it has no value when `expected` is None. Otherwise, the whole transaction is rolled back and `atomic()` returns
+    None.
+
+    :param ops: A list of tuples, each representing an operation on a YottaDB node.
+    :param transid: A string that, when passed "BA" or "BATCH", optionally improves transaction throughput and latency,
+        while removing the guarantee of Durability from ACID transactions.
+    :param names: A tuple of YottaDB local variable names to restore to their original values when the transaction is
+        restarted.
+    :returns: A list of the results of the operations, or None if a `compare_and_set` operation did not apply.
+    """
+    return _yottadb.atomic(_resolve_ops(ops), transid, names)
+
+
+def _resolve_ops(ops: List[Tuple]) -> List[Tuple]:
+    """
+    Replaces the `Node` or `Key` object of each operation for `atomic()` that has one by its variable name and subscript array.
+
+    :param ops: A list of tuples, each representing an operation on a YottaDB node.
+    :returns: A list of tuples of the form accepted by `_yottadb.atomic()`.
+    """
+    return [(op[0], op[1].name, op[1].subsarray, *op[2:]) if 1 < len(op) and isinstance(op[1], Node) else op for op in ops]
+
+
+def compare_and_set(name: AnyStr, subsarray: Tuple[AnyStr] = (), expected: AnyStr = None, value: AnyStr = None) -> bool:
+    """
+    In a single transaction, sets the local or global variable node specified by the `name` and `subsarray` pair to
+    `value` if its value is `expected`. If `expected` is None, the node must have no value, and if `value` is None, the
+    node is deleted instead of set. If both are None, the node is never changed, and the result only reports whether the
+    node has no value.
+
+    :param name: A bytes-like object representing a YottaDB local or global variable name.
+    :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
+    :param expected: A bytes-like object representing the value the node must have, or None if it must have no value.
+    :param value: A bytes-like object representing the new value of the node, or None to delete it.
+    :returns: True if the value of the node was `expected`, and the node was set to `value` (or deleted), or False if its
+        value was not `expected`.
+    """
+    return _yottadb.atomic([("compare_and_set", name, subsarray, expected, value)]) is not None
+
+
+def set_if_absent(name: AnyStr, subsarray: Tuple[AnyStr] = (), value: AnyStr = "") -> bool:
+    """
+    In a single transaction, sets the local or global variable node specified by the `name` and `subsarray` pair to
+    `value` if the node has no value. A node that has a subtree but no value is set.
+
+    :param name: A bytes-like object representing a YottaDB local or global variable name.
+    :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
+    :param value: A bytes-like object representing the new value of the node.
+    :returns: True if the node was set, or False if it already had a value.
+    """
+    if value is None:
+        raise TypeError("'value' must be a bytes-like object")
+    return compare_and_set(name, subsarray, None, value)
+
+
+def delete_if_equals(name: AnyStr, subsarray: Tuple[AnyStr] = (), expected: AnyStr = "") -> bool:
+    """
+    In a single transaction, deletes the value at the local or global variable node specified by the `name` and
+    `subsarray` pair if it is `expected`. Any subtree of the node is left in place.
+
+    :param name: A bytes-like object representing a YottaDB local or global variable name.
+    :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
+    :param expected: A bytes-like object representing the value the node must have.
+    :returns: True if the value was deleted, or False if the node had a different value or none.
+    """
+    if expected is None:
+        raise TypeError("'expected' must be a bytes-like object")
+    return compare_and_set(name, subsarray, expected, None)
+
+
+class AtomicBatch:
+    """
+    A context manager that collects operations on YottaDB nodes and, when its `with` block exits without an exception,
+    executes them in a single transaction using `atomic()`. Since the transaction does not call back into Python, it costs
+    no more than the database operations themselves, but the operations cannot depend on values read in the same block,
+    other than through `compare_and_set()`.
+
+    Each operation takes a `Node` or `Key` object, or a tuple of a variable name and a subscript array, as in `lock()`.
+    The results of the operations are stored in `results` when the batch is committed.
+    """
+
+    __slots__ = ("_ops", "_transid", "_names", "results")
+
+    def __init__(self, transid: str = "", names: Tuple[AnyStr] = None):
+        """
+        Creates a new, empty batch of operations.
+
+        :param transid: A string that, when passed "BA" or "BATCH", optionally improves transaction throughput and latency,
+            while removing the guarantee of Durability from ACID transactions.
+        :param names: A tuple of YottaDB local variable names to restore to their original values when the transaction is
+            restarted.
+        """
+        self._ops = []
+        self._transid = transid
+        self._names = names
+        self.results = None
+
+    def __enter__(self) -> AtomicBatch:
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback) -> bool:
+        if exc_type is None:
+            self.commit()
+        return False
+
+    def __len__(self) -> int:
+        return len(self._ops)
+
+    def _add(self, op: str, node: Union[Node, Key, Tuple[AnyStr, Tuple[AnyStr]]], *args) -> None:
+        if isinstance(node, Node):
+            self._ops.append((op, node.name, node.subsarray, *args))
+        else:
+            self._ops.append((op, *node, *args))
+
+    def get(self, node: Union[Node, Key, Tuple[AnyStr, Tuple[AnyStr]]]) -> None:
+        """
+        Adds an operation that gets the value of `node`, or None if it has no value, to the batch.
+
+        :param node: A `Node` or `Key` object, or a tuple of a variable name and a subscript array.
+        :returns: None.
+        """
+        self._add("get", node)
+
+    def set(self, node: Union[Node, Key, Tuple[AnyStr, Tuple[AnyStr]]], value: AnyStr = "") -> None:
+        """
+        Adds an operation that sets `node` to `value` to the batch.
+
+        :param node: A `Node` or `Key` object, or a tuple of a variable name and a subscript array.
+        :param value: A bytes-like object representing the new value of the node.
+        :returns: None.
+        """
+        self._add("set", node, value)
+
+    def incr(self, node: Union[Node, Key, Tuple[AnyStr, Tuple[AnyStr]]], increment: Union[int, float, str, bytes] = "1") -> None:
+        """
+        Adds an operation that increments `node` by `increment` and gets its new value to the batch.
+
+        :param node: A `Node` or `Key` object, or a tuple of a variable name and a subscript array.
+        :param increment: A numeric value specifying the amount by which to increment the node.
+        :returns: None.
+        """
+        self._add("incr", node, increment if isinstance(increment, (str, bytes)) else str(increment))
+
+    def delete_node(self, node: Union[Node, Key, Tuple[AnyStr, Tuple[AnyStr]]]) -> None:
+        """
+        Adds an operation that deletes the value of `node` to the batch.
+
+        :param node: A `Node` or `Key` object, or a tuple of a variable name and a subscript array.
+        :returns: None.
+        """
+        self._add("delete", node)
+
+    def delete_tree(self, node: Union[Node, Key, Tuple[AnyStr, Tuple[AnyStr]]]) -> None:
+        """
+        Adds an operation that deletes the value and any subtree of `node` to the batch.
+
+        :param node: A `Node` or `Key` object, or a tuple of a variable name and a subscript array.
+        :returns: None.
+        """
+        self._add("delete_tree", node)
+
+    def data(self, node: Union[Node, Key, Tuple[AnyStr, Tuple[AnyStr]]]) -> None:
+        """
+        Adds an operation that gets the result of `data()` for `node` to the batch.
+
+        :param node: A `Node` or `Key` object, or a tuple of a variable name and a subscript array.
+        :returns: None.
+        """
+        self._add("data", node)
+
+    def compare_and_set(self, node: Union[Node, Key, Tuple[AnyStr, Tuple[AnyStr]]], expected: AnyStr, value: AnyStr) -> None:
+        """
+        Adds an operation that sets `node` to `value`, or deletes it if `value` is None, if its value is `expected`, or if it
+        has no value when `expected` is None, to the batch. Otherwise, none of the operations of the batch are applied.
+
+        :param node: A `Node` or `Key` object, or a tuple of a variable name and a subscript array.
+        :param expected: A bytes-like object representing the value the node must have, or None if it must have no value.
+        :param value: A bytes-like object representing the new value of the node, or None to delete it.
+        :returns: None.
+        """
+        self._add("compare_and_set", node, expected, value)
+
+    @property
+    def applied(self) -> bool:
+        """
+        Whether the last commit of the batch was applied, i.e. did not fail a `compare_and_set()` operation.
+
+        :returns: True if the operations were applied, False otherwise.
+        """
+        return self.results is not None
+
+    def commit(self) -> Optional[List]:
+        """
+        Executes the operations collected so far in a single transaction, and empties the batch.
+
+        :returns: A list of the results of the operations, as returned by `atomic()`, or None if a `compare_and_set()`
+            operation did not apply, in which case none of the operations were applied.
+        """
+        ops, self._ops = self._ops, []
+        self.results = _yottadb.atomic(ops, self._transid, self._names)
+        return self.results
+
+
+class _CommitGroup:
+    """
+    The batches of operations submitted to a `GroupCommitter` during one window, and their outcomes.
+    """
+
+    __slots__ = ("ops", "sizes", "outcomes", "full", "done")
+
+    def __init__(self):
+        self.ops = []
+        self.sizes = []
+        self.outcomes = None
+        self.full = threading.Event()
+        self.done = threading.Event()
+
+
+class GroupCommitter:
+    """
+    Coalesces batches of operations submitted by concurrent threads into shared transactions. The first thread to submit
+    a batch after a commit waits for up to `window` seconds, or until `max_ops` operations are pending, and then executes
+    all batches submitted in the meantime in a single transaction using `atomic()`, and hands the outcome of each batch
+    back to the thread that submitted it. This trades a bounded increase in latency for fewer transaction commits.
+
+    If a `compare_and_set` operation of any batch does not apply, or any batch is invalid, the batches of the group are
+    executed in separate transactions instead, so that each batch is applied or not independently of the others.
+
+    Batches are only coalesced within a process. Batches of different processes are committed separately.
+
+    A batch submitted from within a transaction, e.g. from a `tp()` callback, cannot wait for a group, since the calling
+    thread holds the API lock until its transaction completes. Such a batch is instead executed immediately, in a
+    transaction nested in that of the caller, without being coalesced with other batches.
+    """
+
+    __slots__ = ("_window", "_max_ops", "_transid", "_lock", "_group")
+
+    def __init__(self, window: float = 0.001, max_ops: int = 1024, transid: str = ""):
+        """
+        Creates a new `GroupCommitter` object.
+
+        :param window: The time in seconds that the first batch of a group waits for other batches to join it.
+        :param max_ops: The number of pending operations at which a group is committed without waiting for its window
+            to end.
+        :param transid: A string that, when passed "BA" or "BATCH", optionally improves transaction throughput and latency,
+            while removing the guarantee of Durability from ACID transactions.
+        """
+        if window < 0:
+            raise ValueError("'window' must not be negative")
+        self._window = window
+        self._max_ops = max_ops
+        self._transid = transid
+        self._lock = threading.Lock()
+        self._group = None
+
+    def submit(self, ops: Union[List[Tuple], AtomicBatch]) -> Optional[List]:
+        """
+        Submits a batch of operations, of the form accepted by `atomic()`, to be executed in the next group transaction,
+        and waits for that transaction to complete.
+
+        :param ops: A list of tuples, each representing an operation on a YottaDB node, or an `AtomicBatch` object, of which
+            the operations are taken, and in which the results are stored.
+        :returns: A list of the results of the operations, or None if a `compare_and_set` operation did not apply, in which
+            case none of the operations of the batch were applied.
+        """
+        batch = None
+        if isinstance(ops, AtomicBatch):
+            batch = ops
+            ops, batch._ops = batch._ops, []
+        else:
+            ops = _resolve_ops(ops)
+        if 0 < int(_yottadb.get("$TLEVEL")):
+            # The calling thread holds the API lock for its transaction, which the leader of a group needs to commit it,
+            # so the batch is executed immediately, as a transaction nested in that of the caller
+            results, error = self._commit_batch(ops)
+        else:
+            results, error = self._submit_to_group(ops)
+        if error is not None:
+            raise error
+        if batch is not None:
+            batch.results = results
+        return results
+
+    def _submit_to_group(self, ops: List[Tuple]) -> Tuple[Optional[List], Optional[BaseException]]:
+        """
+        Adds a batch of operations to the pending group, committing the group if the calling thread is its leader, and
+        waits for the outcome of the batch.
+
+        :param ops: A list of tuples, each representing an operation on a YottaDB node.
+        :returns: A tuple of the results of the batch and None, or of None and the exception raised by the batch.
+        """
+        with self._lock:
+            group = self._group
+            is_leader = group is None
+            if is_leader:
+                group = self._group = _CommitGroup()
+            index = len(group.sizes)
+            group.ops.extend(ops)
+            group.sizes.append(len(ops))
+            if self._max_ops <= len(group.ops):
+                group.full.set()
+        if not is_leader:
+            group.done.wait()
+            return group.outcomes[index]
+        try:
+            group.full.wait(self._window)
+            # Close the group, so that batches submitted from now on start the next one
+            with self._lock:
+                self._group = None
+            self._commit(group)
+        except BaseException as error:
+            # Hand the error to the batches that have no outcome yet, so that their threads do not wait forever
+            with self._lock:
+                if self._group is group:
+                    self._group = None
+            outcomes = group.outcomes or []
+            group.outcomes = outcomes + [(None, error)] * (len(group.sizes) - len(outcomes))
+        finally:
+            group.done.set()
+        return group.outcomes[index]
+
+    def _commit(self, group: _CommitGroup) -> None:
+        """
+        Executes the batches of `group` in a single transaction, or in one transaction per batch if a `compare_and_set`
+        operation did not apply or any batch is invalid, and stores the outcome of each batch in the group.
+
+        :param group: The `_CommitGroup` object to commit.
+        :returns: None.
+        """
+        results, error = self._commit_batch(group.ops)
+        if 1 == len(group.sizes):
+            group.outcomes = [(results, error)]
+            return
+        group.outcomes = []
+        start = 0
+        for size in group.sizes:
+            if results is not None:
+                group.outcomes.append((results[start : start + size], None))
+            else:
+                group.outcomes.append(self._commit_batch(group.ops[start : start + size]))
+            start += size
+
+    def _commit_batch(self, ops: List[Tuple]) -> Tuple[Optional[List], Optional[Exception]]:
+        """
+        Executes a single batch of operations in its own transaction.
+
+        :param ops: A list of tuples, each representing an operation on a YottaDB node.
+        :returns: A tuple of the results of the batch and None, or of None and the exception raised by the batch.
+        """
+        try:
+            return (_yottadb.atomic(ops, self._transid), None)
+        except Exception as error:
+            return (None, error)
+
+
 def node_to_dict(node: Tuple[AnyStr, Tuple[AnyStr]], child_subs: List[AnyStr], result: dict) -> Mapping:
     """
     Recursively constructs a series of nested dictionaries representing a the YottaDB node specified by `node` using
@@ -443,7 +1455,7 @@ def node_to_dict(node: Tuple[AnyStr, Tuple[AnyStr]], child_subs: List[AnyStr], r
         # and cease recursing.
         node_status = data(node[0], list(node[1]) + list(child_subs))
         if node_status == 1 or node_status == 11:
-            result[sub]["value"] = get(node[0], list(node[1]) + list(child_subs)).decode("utf-8")
+            result[sub]["value"] = get(node[0], list(node[1]) + list(child_subs), decode="utf-8")
     elif len(child_subs) > 1:
         # There are more subscripts to convert to dictionary keys, continue
         # recursing with `node_to_dict()`
@@ -552,9 +1564,8 @@ def load_tree(node: [Node, Key], child_subs: List[AnyStr] = None, result: dict =
     if first_call and (node.data == 1 or node.data == 11):
         # Store the value of the root database node before recursively retrieving its
         # child nodes.
-        result["value"] = node.value.decode("utf-8")
-    for sub in subscripts(name, subsarray + [""]):
-        sub = sub.decode("utf-8")
+        result["value"] = get(name, subsarray, decode="utf-8")
+    for sub in subscripts(name, subsarray + [""], decode="utf-8"):
         node_to_dict((name, subsarray), tuple(child_subs + [sub]), result)
         load_tree(node[sub], child_subs + [sub], result)
     return result
@@ -566,17 +1577,46 @@ class SubscriptsIter:
     specified by the `name` and `subsarray` pair passed to the `__init__()` constructor.
     """
 
-    def __init__(self, name: AnyStr, subsarray: Tuple[AnyStr] = ()) -> SubscriptsIter:
+    def __init__(
+        self,
+        name: AnyStr,
+        subsarray: Tuple[AnyStr] = (),
+        start: Optional[AnyStr] = None,
+        stop: Optional[AnyStr] = None,
+        prefix: Optional[AnyStr] = None,
+        limit: Optional[int] = None,
+        reverse: bool = False,
+        decode: str = None,
+        errors: str = "strict",
+    ) -> SubscriptsIter:
         """
         Creates a `SubscriptsIter` class object from the local or global variable node specified
-        by the `name` and `subsarray` pair.
+        by the `name` and `subsarray` pair. If any of `start`, `stop`, `prefix`, `limit` or `reverse`
+        are specified, only the subscripts within those boundaries are iterated over, as described
+        for `subscripts()`.
 
         :param name: A bytes-like object representing a YottaDB local or global variable name.
         :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
+        :param start: An optional bytes-like object representing the first subscript in collation order to be yielded.
+        :param stop: An optional bytes-like object representing the subscript that ends the range in collation order.
+        :param prefix: An optional bytes-like object that all subscripts yielded must begin with.
+        :param limit: An optional maximum number of subscripts to yield.
+        :param reverse: Whether to yield the subscripts in reverse collation order.
+        :param decode: The encoding with which to decode the subscripts into str objects, e.g. "utf-8", or None for bytes
+            objects.
+        :param errors: The error handler for decoding, e.g. "strict", "replace" or "surrogateescape".
         :returns: A `SubscriptsIter` object.
         """
+        if limit is not None and 0 > limit:
+            raise ValueError(f"'limit' must be non-negative, not {limit}")
         self._name = name
         self._subsarray = list(subsarray)
+        self._bounds = (start, stop, prefix, limit, reverse)
+        self._decode = decode
+        self._errors = errors
+        self._scan = None
+        if start is not None or stop is not None or prefix is not None or limit is not None or reverse:
+            self._scan = scan_subscripts(name, subsarray, start, stop, prefix, limit, reverse)
 
     def __iter__(self) -> SubscriptsIter:
         """
@@ -593,58 +1633,110 @@ class SubscriptsIter:
         the `self._name` and `self._subsarray` pair, and updates `self._subsarray` with this next subscript
         in preparation for the next `__next__()` call.
 
-        :returns: A bytes object representing the next subscript relative to the current local or global variable node.
+        :returns: A bytes object representing the next subscript relative to the current local or global variable node, or
+            a str object if `decode` was given.
         """
-        try:
-            if len(self._subsarray) > 0:
-                sub_next = subscript_next(self._name, self._subsarray)
-                self._subsarray[-1] = sub_next
-            else:
-                # There are no subscripts and this is a variable-level iteration,
-                # so do not modify subsarray (it is empty), but update the variable
-                # name to the next variable instead.
-                sub_next = subscript_next(self._name)
-                self._name = sub_next
-        except YDBNodeEnd:
-            raise StopIteration
-        return sub_next
-
-    def __reversed__(self) -> list:
-        """
-        Creates a new iterable by compiling a list of all subscripts preceding the current local or global variable
-        node represented by the `self._name` and `self._subsarray` pair. The result is the list of subscripts from
-        the current node in reverse order, which is then returned.
+        if self._scan is not None:
+            sub_next = next(self._scan)
+            return sub_next if self._decode is None else sub_next.decode(self._decode, self._errors)
+        # Pass None as the default return value to detect the end of iteration without raising YDBNodeEnd
+        if len(self._subsarray) > 0:
+            sub_next = _yottadb.subscript_next(self._name, self._subsarray, None)
+            if sub_next is None:
+                raise StopIteration
+            self._subsarray[-1] = sub_next
+        else:
+            # There are no subscripts and this is a variable-level iteration,
+            # so do not modify subsarray (it is empty), but update the variable
+            # name to the next variable instead.
+            sub_next = _yottadb.subscript_next(self._name, (), None)
+            if sub_next is None:
+                raise StopIteration
+            self._name = sub_next
+        # The subscript is kept as a bytes object to resume the iteration exactly, and only decoded as it is returned
+        return sub_next if self._decode is None else sub_next.decode(self._decode, self._errors)
+
+    def __reversed__(self) -> SubscriptsIter:
+        """
+        Creates a `SubscriptsIter` object that lazily yields the subscripts preceding the current local or global variable
+        node represented by the `self._name` and `self._subsarray` pair in reverse order, within the same boundaries as the
+        current object, or in forward order if the current object is itself reversed. The subscripts are retrieved in chunks
+        of at most `scan_chunk_size` subscripts, so memory use is bounded regardless of the number of subscripts, and
+        retrieving the last N subscripts requires only N subscripts to be read.
 
-        :returns: A list of bytes objects representing the set of subscripts preceding the current local or global variable node.
+        :returns: A `SubscriptsIter` object.
         """
-        result = []
-        while True:
-            try:
-                sub_next = subscript_previous(self._name, self._subsarray)
-                if len(self._subsarray) != 0:
-                    self._subsarray[-1] = sub_next
-                else:
-                    # There are no subscripts and this is a variable-level iteration,
-                    # so do not modify subsarray (it is empty), but update the variable
-                    # name to the next variable instead.
-                    self._name = sub_next
-                result.append(sub_next)
-            except YDBNodeEnd:
-                break
-        return result
+        start, stop, prefix, limit, reverse = self._bounds
+        return SubscriptsIter(self._name, self._subsarray, start, stop, prefix, limit, not reverse, self._decode, self._errors)
+
+
+def scan_subscripts(
+    name: AnyStr,
+    subsarray: Tuple[AnyStr],
+    start: Optional[AnyStr],
+    stop: Optional[AnyStr],
+    prefix: Optional[AnyStr],
+    limit: Optional[int],
+    reverse: bool,
+) -> Generator:
+    """
+    A Generator that yields the subscripts following (or preceding, if `reverse` is set) the local or global
+    variable node specified by the `name` and `subsarray` pair that are within the given boundaries, retrieving
+    them from `_yottadb.subscript_scan()` in chunks of at most `scan_chunk_size` subscripts.
+
+    :returns: A bytes object representing a subscript within the given boundaries.
+    """
+    subsarray = list(subsarray)
+    remaining = limit
+    while remaining is None or 0 < remaining:
+        count = scan_chunk_size if remaining is None else min(remaining, scan_chunk_size)
+        chunk = _yottadb.subscript_scan(name, subsarray, start, stop, prefix, count, reverse)
+        yield from chunk
+        if len(chunk) < count:
+            return
+        if remaining is not None:
+            remaining -= len(chunk)
+        # Resume the scan after the last subscript retrieved
+        if len(subsarray) > 0:
+            subsarray[-1] = chunk[-1]
+        else:
+            name = chunk[-1]
 
 
-def subscripts(name: AnyStr, subsarray: Tuple[AnyStr] = ()) -> SubscriptsIter:
+def subscripts(
+    name: AnyStr,
+    subsarray: Tuple[AnyStr] = (),
+    start: Optional[AnyStr] = None,
+    stop: Optional[AnyStr] = None,
+    prefix: Optional[AnyStr] = None,
+    limit: Optional[int] = None,
+    reverse: bool = False,
+    decode: str = None,
+    errors: str = "strict",
+) -> SubscriptsIter:
     """
     A convenience function that yields a `SubscriptsIter` class object from the local or global
     variable node specified by the `name` and `subsarray` pair, providing a more readable
     interface for generating `SubscriptsIter` objects than calling the class constructor.
 
+    If any of `start`, `stop`, `prefix`, `limit` or `reverse` are specified, the `SubscriptsIter` object only yields
+    the subscripts following (or preceding, if `reverse` is set) the last subscript in `subsarray` that collate between
+    `start` (inclusive) and `stop` (exclusive), begin with `prefix`, and number no more than `limit`. These boundaries are
+    evaluated by `_yottadb.subscript_scan()` using YottaDB collation order, so the scan begins at `start` or `prefix` and
+    ends as soon as a subscript passes `stop` or no longer begins with `prefix`.
+
     :param name: A bytes-like object representing a YottaDB local or global variable name.
     :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
+    :param start: An optional bytes-like object representing the first subscript in collation order to be yielded.
+    :param stop: An optional bytes-like object representing the subscript that ends the range in collation order.
+    :param prefix: An optional bytes-like object that all subscripts yielded must begin with.
+    :param limit: An optional maximum number of subscripts to yield.
+    :param reverse: Whether to yield the subscripts in reverse collation order.
+    :param decode: The encoding with which to decode the subscripts into str objects, e.g. "utf-8", or None for bytes objects.
+    :param errors: The error handler for decoding, e.g. "strict", "replace" or "surrogateescape".
     :returns: A `SubscriptsIter` object.
     """
-    return SubscriptsIter(name, subsarray)
+    return SubscriptsIter(name, subsarray, start, stop, prefix, limit, reverse, decode, errors)
 
 
 class NodesIter:
@@ -653,18 +1745,40 @@ class NodesIter:
     specified by the `name` and `subsarray` pair passed to the `__init__()` constructor.
     """
 
-    def __init__(self, name: AnyStr, subsarray: Tuple[AnyStr] = ()):
+    def __init__(
+        self,
+        name: AnyStr,
+        subsarray: Tuple[AnyStr] = (),
+        start: Optional[Tuple[AnyStr]] = None,
+        stop: Optional[Tuple[AnyStr]] = None,
+        prefix: Optional[Tuple[AnyStr]] = None,
+        limit: Optional[int] = None,
+        reverse: bool = False,
+    ):
         """
         Creates a `NodesIter` class object from the local or global variable node specified
-        by the `name` and `subsarray` pair.
+        by the `name` and `subsarray` pair. If any of `start`, `stop`, `prefix`, `limit` or `reverse`
+        are specified, only the nodes within those boundaries are iterated over, as described
+        for `nodes()`.
 
         :param name: A bytes-like object representing a YottaDB local or global variable name.
         :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
+        :param start: An optional tuple of bytes-like objects representing the first node in collation order to be yielded.
+        :param stop: An optional tuple of bytes-like objects representing the node that ends the range in collation order.
+        :param prefix: An optional tuple of bytes-like objects representing the subtree that all nodes yielded must be in.
+        :param limit: An optional maximum number of nodes to yield.
+        :param reverse: Whether to yield the nodes in reverse collation order.
         :returns: A `NodesIter` object.
         """
+        if limit is not None and 0 > limit:
+            raise ValueError(f"'limit' must be non-negative, not {limit}")
         self._name = name
         self._subsarray = [bytes(x, encoding="UTF-8") if isinstance(x, str) else x for x in subsarray]
         self.initialized = False
+        self._bounds = (start, stop, prefix, limit, reverse)
+        self._scan = None
+        if start is not None or stop is not None or prefix is not None or limit is not None or reverse:
+            self._scan = scan_nodes(name, self._subsarray, start, stop, prefix, limit, reverse)
 
     def __iter__(self) -> NodesIter:
         """
@@ -684,24 +1798,30 @@ class NodesIter:
         :returns: A tuple of bytes objects representing the subscript array for the next node relative to the current local
             or global variable node.
         """
+        if self._scan is not None:
+            return next(self._scan)
         if not self.initialized:
             self.initialized = True
             status = data(self._name)
             if 0 == len(self._subsarray) and (1 == status or 11 == status):
                 return tuple(self._subsarray)
-        try:
-            self._subsarray = node_next(self._name, self._subsarray)
-        except YDBNodeEnd:
+        subsarray = _yottadb.node_next(self._name, self._subsarray, None)
+        if subsarray is None:
             raise StopIteration
+        self._subsarray = subsarray
         return self._subsarray
 
     def __reversed__(self):
         """
         Creates a new iterable for iterating over nodes preceding the current local or global variable in reverse by
-        creating a new `NodesIterReversed` object and returning it.
+        creating a new `NodesIterReversed` object and returning it. If any boundaries were specified, a `NodesIter` object
+        that iterates within the same boundaries in the opposite direction is returned instead.
 
-        :returns: A NodesIterReversed object.
+        :returns: A NodesIterReversed or NodesIter object.
         """
+        start, stop, prefix, limit, reverse = self._bounds
+        if self._scan is not None:
+            return NodesIter(self._name, self._subsarray, start, stop, prefix, limit, not reverse)
         return NodesIterReversed(self._name, self._subsarray)
 
 
@@ -722,8 +1842,7 @@ class NodesIterReversed:
         """
         self._name = name
         self._subsarray = [bytes(x, encoding="UTF-8") if isinstance(x, str) else x for x in subsarray]
-        self.reversed = [bytes(x, encoding="UTF-8") if isinstance(x, str) else x for x in subsarray]
-        self.initialized = False
+        self._nodes = None
 
     def __iter__(self):
         """
@@ -737,39 +1856,31 @@ class NodesIterReversed:
     def __next__(self):
         """
         Returns the subscript array of the previous node relative to the current local or global variable node represented by
-        the `self._name` and `self.reversed` pair, and updates `self.reversed` with this new subscript array
-        in preparation for the next `__next__()` call.
+        the `self._name` and `self._subsarray` pair. The nodes are retrieved lazily, in chunks of at most `scan_chunk_size`
+        nodes, so memory use is bounded regardless of the number of nodes.
 
         :returns: A tuple of bytes objects representing the subscript array for the previous node relative to the current local
             or global variable node.
         """
-        # If this is the first iteration, then the last node of the reversed node iteration
-        # is not yet known. So first look that up and return it, then signal to future calls
-        # that this node is known by setting self.initialized, in which case future iterations
-        # will skip last node lookup and simply return the preceding node via node_previous().
-        if not self.initialized:
-            # If the given subscript array points to a node or tree, append a "" subscript
-            # to the subscript list to attempt to look up last subscript at the depth
-            # of that array +1. If the subscript array doesn't point to a node or tree, then
-            # it can be used as is to look up the last subscript at the given depth.
-            if 0 < data(self._name, self._subsarray):
-                self.reversed.append("")
-            while not self.initialized:
-                try:
-                    # If there is another subscript level, add its last subscript to the subscript list
-                    self.reversed.insert(len(self.reversed) - 1, subscript_previous(self._name, self.reversed))
-                except YDBNodeEnd:
-                    # Remove "" subscript now that the search for the last node is complete
-                    self.reversed.pop()
-                    self.initialized = True
-            return tuple(self.reversed)
+        if self._nodes is None:
+            self._nodes = self._scan()
+        return next(self._nodes)
 
-        try:
-            self.reversed = node_previous(self._name, self.reversed)
-        except YDBNodeEnd:
-            raise StopIteration
+    def _scan(self) -> Generator:
+        """
+        A Generator that yields the last node of the subtree of the given node, if there is one, followed by each
+        preceding node.
 
-        return self.reversed
+        :returns: A tuple of bytes objects representing the subscript array of a node.
+        """
+        start = self._subsarray
+        # Look up the last node in the subtree of the given node, if any, and continue from there
+        for start in _yottadb.node_scan(self._name, (), prefix=self._subsarray, count=1, reverse=True):
+            yield start
+            # No node precedes the root node, and an empty subsarray would restart the scan from the last node
+            if () == start:
+                return
+        yield from scan_nodes(self._name, start, None, None, None, None, True)
 
     def __reversed__(self):
         """
@@ -778,20 +1889,203 @@ class NodesIterReversed:
 
         :returns: A NodesIter object.
         """
-        return NodesIter(self._name, self.subarray)
-
-
-def nodes(name: AnyStr, subsarray: Tuple[AnyStr] = ()) -> NodesIter:
+        return NodesIter(self._name, self._subsarray)
+
+
+def scan_nodes(
+    name: AnyStr,
+    subsarray: Tuple[AnyStr],
+    start: Optional[Tuple[AnyStr]],
+    stop: Optional[Tuple[AnyStr]],
+    prefix: Optional[Tuple[AnyStr]],
+    limit: Optional[int],
+    reverse: bool,
+) -> Generator:
+    """
+    A Generator that yields the subscript arrays of the nodes following (or preceding, if `reverse` is set) the local or
+    global variable node specified by the `name` and `subsarray` pair that are within the given boundaries, retrieving
+    them from `_yottadb.node_scan()` in chunks of at most `scan_chunk_size` nodes.
+
+    :returns: A tuple of bytes objects representing the subscript array of a node within the given boundaries.
+    """
+    # As with NodesIter, include the root node of the variable when iterating forward from it
+    if not reverse and start is None and 0 == len(subsarray):
+        start = ()
+    remaining = limit
+    while remaining is None or 0 < remaining:
+        count = scan_chunk_size if remaining is None else min(remaining, scan_chunk_size)
+        chunk = _yottadb.node_scan(name, subsarray, start, stop, prefix, count, reverse)
+        yield from chunk
+        # No node precedes the root node, and an empty subsarray would restart a reverse scan from the last node
+        if len(chunk) < count or (reverse and () == chunk[-1]):
+            return
+        if remaining is not None:
+            remaining -= len(chunk)
+        # Resume the scan after the last node retrieved
+        subsarray = chunk[-1]
+
+
+def nodes(
+    name: AnyStr,
+    subsarray: Tuple[AnyStr] = (),
+    start: Optional[Tuple[AnyStr]] = None,
+    stop: Optional[Tuple[AnyStr]] = None,
+    prefix: Optional[Tuple[AnyStr]] = None,
+    limit: Optional[int] = None,
+    reverse: bool = False,
+) -> NodesIter:
     """
     A convenience function that yields a `NodesIter` class object from the local or global
     variable node specified by the `name` and `subsarray` pair, providing a more readable
     interface for generating `NodesIter` objects than calling the class constructor.
 
+    If any of `start`, `stop`, `prefix`, `limit` or `reverse` are specified, the `NodesIter` object only yields
+    the subscript arrays of the nodes with values following (or preceding, if `reverse` is set) the given node that collate
+    between the `start` (inclusive) and `stop` (exclusive) subscript arrays, are in the subtree of the `prefix` subscript
+    array, and number no more than `limit`. In reverse, an empty `subsarray` starts from the last node of the variable.
+    These boundaries are evaluated by `_yottadb.node_scan()` using YottaDB collation order, so the scan begins at `start`
+    or `prefix` and ends as soon as a node passes `stop` or leaves the subtree of `prefix`.
+
     :param name: A bytes-like object representing a YottaDB local or global variable name.
     :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts.
+    :param start: An optional tuple of bytes-like objects representing the first node in collation order to be yielded.
+    :param stop: An optional tuple of bytes-like objects representing the node that ends the range in collation order.
+    :param prefix: An optional tuple of bytes-like objects representing the subtree that all nodes yielded must be in.
+    :param limit: An optional maximum number of nodes to yield.
+    :param reverse: Whether to yield the nodes in reverse collation order.
     :returns: A `NodesIter` object.
     """
-    return NodesIter(name, subsarray)
+    return NodesIter(name, subsarray, start, stop, prefix, limit, reverse)
+
+
+class NodeView(MutableMapping):
+    """
+    A `collections.abc.MutableMapping` over the child nodes of a YottaDB local or global variable node, created by `Node.view()`.
+
+    Keys are the child subscripts of the node, as bytes objects. The value for a key is the value of the child node as
+    a bytes object if the child node has no subtree, or a `NodeView` of the child node if it does. Child nodes are only
+    read from the database when they are accessed, and assignments and deletions are written through to the database.
+    """
+
+    def __init__(self, node: Node):
+        """
+        Creates a `NodeView` object for the local or global variable node represented by `node`.
+
+        :param node: A `Node` object representing the root of the subtree.
+        :returns: A `NodeView` object.
+        """
+        self._node = node.copy()
+
+    def __repr__(self) -> str:
+        return f"{self.__class__.__name__}({self._node!r})"
+
+    @staticmethod
+    def _key(key: AnyStr) -> bytes:
+        if isinstance(key, str):
+            return bytes(key, encoding="UTF-8")
+        elif isinstance(key, bytes):
+            return key
+        raise TypeError(f"'key' must be an instance of str or bytes, not {type(key).__name__}")
+
+    def __getitem__(self, key: AnyStr) -> Union[bytes, NodeView]:
+        """
+        Retrieve the child node with subscript `key`.
+
+        :param key: A bytes-like object representing a child subscript.
+        :returns: The value of the child node as a bytes object if it has no subtree, or a `NodeView` of the child node otherwise.
+        :raises KeyError: If the child node has neither a value nor a subtree.
+        """
+        key = self._key(key)
+        status, value = fetch(self._node.name, self._node.subsarray + [key])
+        if YDB_DATA_UNDEF == status:
+            raise KeyError(key)
+        if YDB_DATA_VALUE_NODESC == status:
+            return value
+        return NodeView(self._node[key])
+
+    @staticmethod
+    def _snapshot(value: Mapping) -> Tuple[Optional[AnyStr], dict]:
+        # Copy `value` into plain data, recursively, so that it survives the deletion of any subtree it is a view of
+        root = value.value if isinstance(value, NodeView) else None
+        items = {}
+        for sub, sub_value in value.items():
+            if isinstance(sub_value, Mapping):
+                items[sub] = NodeView._snapshot(sub_value)
+            elif isinstance(sub_value, (str, bytes)):
+                items[sub] = sub_value
+            else:
+                raise TypeError(f"values must be instances of str, bytes or Mapping, not {type(sub_value).__name__}")
+        return root, items
+
+    @staticmethod
+    def _restore(node: Node, snapshot: Tuple[Optional[AnyStr], dict]) -> None:
+        root, items = snapshot
+        if root is not None:
+            node.value = root
+        for sub, sub_value in items.items():
+            if isinstance(sub_value, tuple):
+                NodeView._restore(node[sub], sub_value)
+            else:
+                node[sub].value = sub_value
+
+    def __setitem__(self, key: AnyStr, value: Union[AnyStr, Mapping]) -> None:
+        """
+        Set the child node with subscript `key`. If `value` is a bytes-like object, it is stored as the value of the child node.
+        If `value` is a mapping, the subtree of the child node is replaced with its contents. If `value` is a `NodeView`,
+        the value of its root node is copied as well, so `view[key] = view[key]` leaves the subtree unchanged.
+
+        :param key: A bytes-like object representing a child subscript.
+        :param value: A bytes-like object or a mapping.
+        :returns: None.
+        """
+        key = self._key(key)
+        if isinstance(value, Mapping):
+            # Copy the new contents before deleting the existing subtree, in case `value` is a view of it
+            snapshot = self._snapshot(value)
+            child = self._node[key]
+            child.delete_tree()
+            self._restore(child, snapshot)
+        else:
+            set(self._node.name, self._node.subsarray + [key], value)
+
+    def __delitem__(self, key: AnyStr) -> None:
+        """
+        Delete the child node with subscript `key`, including its subtree.
+
+        :param key: A bytes-like object representing a child subscript.
+        :returns: None.
+        :raises KeyError: If the child node has neither a value nor a subtree.
+        """
+        key = self._key(key)
+        subsarray = self._node.subsarray + [key]
+        if YDB_DATA_UNDEF == data(self._node.name, subsarray):
+            raise KeyError(key)
+        delete_tree(self._node.name, subsarray)
+
+    def __contains__(self, key: object) -> bool:
+        if not isinstance(key, (str, bytes)):
+            return False
+        return YDB_DATA_UNDEF != data(self._node.name, self._node.subsarray + [self._key(key)])
+
+    def __iter__(self) -> Iterator[bytes]:
+        return SubscriptsIter(self._node.name, self._node.subsarray + [b""])
+
+    def __len__(self) -> int:
+        return subscript_count(self._node.name, self._node.subsarray)
+
+    @property
+    def node(self) -> Node:
+        """
+        The `Node` object representing the root of the subtree.
+        """
+        return self._node
+
+    @property
+    def value(self) -> Optional[bytes]:
+        """
+        The value of the root node of the subtree, or None if it has no value.
+        """
+        return self._node.value
 
 
 class Node:
@@ -800,8 +2094,17 @@ class Node:
     for performing various database operations on or relative to that node.
     """
 
+    # Each child Node links to its parent Node and holds only its own subscript, so that creating a child takes constant time
+    # and memory. The full subscript array of a Node is only assembled, and then cached in _path, when a database call needs
+    # it. A Node created from a subscript array has no parent and always holds its subscript array in _path.
+    __slots__ = ("_name", "_parent", "_leaf", "_depth", "_path", "_hash", "_mutable")
+
     _name: AnyStr
-    _subsarray: List
+    _parent: Optional[Node]
+    _leaf: Optional[AnyStr]
+    _depth: int
+    _path: Optional[List]
+    _hash: Optional[int]
     _mutable: bool
 
     def __init__(self, name: AnyStr, subsarray: List = None) -> Node:
@@ -822,22 +2125,75 @@ class Node:
         self._name = name
         # Make the new Node immutable by default
         self._mutable = False
+        self._parent = None
+        self._hash = None
         # Set the subsarray field, based on the passed `subsarray` list.
         if subsarray is None:
             # If no subsarray was specified, initialize an empty list for
             # compatibility with methods that expect subsarray to be a list
-            self._subsarray = []
+            self._path = []
         else:
             # Take a shallow copy of the received subsarray to prevent mutation side-effects
             if isinstance(subsarray, list):
-                self._subsarray = subsarray.copy()
+                self._path = subsarray.copy()
             elif isinstance(subsarray, tuple):
-                self._subsarray = list(subsarray)
+                self._path = list(subsarray)
             else:
                 raise TypeError("'subsarray' must be an instance of list or tuple")
+        self._depth = len(self._path)
+        self._leaf = self._path[-1] if self._depth > 0 else None
+
+        if _yottadb.YDB_MAX_SUBS < self._depth:
+            raise ValueError(f"Cannot create Node with {self._depth} subscripts (max: {_yottadb.YDB_MAX_SUBS})")
 
-        if _yottadb.YDB_MAX_SUBS < len(self._subsarray):
-            raise ValueError(f"Cannot create Node with {len(self._subsarray)} subscripts (max: {_yottadb.YDB_MAX_SUBS})")
+    def _child(self, subscript: AnyStr) -> Node:
+        """
+        Creates a new `Node` object representing the child node of the current `Node` object with the given subscript,
+        in constant time. The child links to the current `Node` object, or to an immutable copy of it if it is mutable,
+        so that the child does not change when the current `Node` object does.
+
+        :param subscript: A bytes-like object representing a YottaDB subscript name.
+        :returns: A new `Node` object.
+        """
+        if _yottadb.YDB_MAX_SUBS <= self._depth:
+            raise ValueError(f"Cannot create Node with {self._depth + 1} subscripts (max: {_yottadb.YDB_MAX_SUBS})")
+        child = Node.__new__(Node)
+        child._name = self._name
+        child._parent = self.copy() if self._mutable else self
+        child._leaf = subscript
+        child._depth = self._depth + 1
+        child._path = None
+        child._hash = None
+        child._mutable = False
+        return child
+
+    def _set_leaf(self, subscript: AnyStr) -> None:
+        """
+        Changes the final subscript of the current mutable `Node` object, updating its cached subscript array in place.
+
+        :param subscript: A bytes-like object representing a YottaDB subscript name.
+        :returns: None.
+        """
+        self._leaf = subscript
+        if self._path is not None:
+            self._path[-1] = subscript
+
+    @property
+    def _subsarray(self) -> List[AnyStr]:
+        """
+        The full subscript array of the current `Node` object, assembled from the subscripts of its ancestors on first use.
+
+        :returns: A list of bytes-like objects representing the subscript array of the current `Node` object.
+        """
+        if self._path is None:
+            leaves = []
+            node = self
+            while node._path is None:
+                leaves.append(node._leaf)
+                node = node._parent
+            leaves.reverse()
+            self._path = node._path + leaves
+        return self._path
 
     def __repr__(self) -> str:
         """
@@ -890,7 +2246,7 @@ class Node:
         :param item: A bytes-like object representing a YottaDB subscript name.
         :returns: A new `Node` object.
         """
-        return Node(self._name, self._subsarray + [item])
+        return self._child(item)
 
     def __iadd__(self, num: Union[int, float, str, bytes]) -> Node:
         """
@@ -922,14 +2278,35 @@ class Node:
         """
         Evaluates whether the current `Node` object represents the same YottaDB local or global variable name as `other`.
 
+        If `other` is not a `Node` object, the value of the node is compared with it instead.
+
         :param other: A `Node` object representing a valid YottaDB local or global variable node.
         :returns: True if the two `Node`s represent the same node, or False otherwise.
         """
         if isinstance(other, Node):
-            return self._name == other.name and self._subsarray == other.subsarray
+            return self._name == other.name and self._depth == other._depth and self._subsarray == other.subsarray
         else:
             return self.value == other
 
+    def __hash__(self) -> int:
+        """
+        Hashes the variable name and subscript array of the current `Node` object. The hash is cached, since the variable
+        name and subscript array of an immutable `Node` object never change. Mutable `Node` objects, such as those yielded
+        by iterating over a `Node`, are not hashable, since they change on each iteration.
+
+        Since a `Node` object also compares equal to its value, e.g. `Node("^x") == b"val"`, but its hash only depends on
+        its variable name and subscript array, equality with values is not consistent with the hash. Sets and dictionaries
+        with `Node` keys should therefore not also contain other keys.
+
+        :returns: The hash of the current `Node` object.
+        :raises TypeError: If the `Node` object is mutable.
+        """
+        if self._hash is None:
+            if self._mutable:
+                raise TypeError("unhashable type: mutable 'Node'")
+            self._hash = hash((self._name, tuple(self._subsarray)))
+        return self._hash
+
     def __iter__(self) -> Generator:
         """
         A Generator that successively yields mutable `Node` objects representing each child node of the local or
@@ -939,16 +2316,16 @@ class Node:
         """
         # Duplicate calling Node with next subscript level initialized to ""
         # to prevent mutation of caller during successive iterations
-        next_node = self("")
+        next_node = self._child("")
         # Flag the new node as mutable to signal to users of the new object
         # that it may change on subsequent loop iterations
         next_node._mutable = True
         while True:
-            try:
-                next_node._subsarray[-1] = next_node.subscript_next()
-                yield next_node
-            except YDBNodeEnd:
+            sub_next = _yottadb.subscript_next(next_node._name, next_node._subsarray, None)
+            if sub_next is None:
                 return
+            next_node._set_leaf(sub_next)
+            yield next_node
 
     def __reversed__(self) -> Generator:
         """
@@ -959,16 +2336,16 @@ class Node:
         """
         # Duplicate calling Node with next subscript level initialized to ""
         # to prevent mutation of caller during successive iterations
-        prev_node = self("")
+        prev_node = self._child("")
         # Flag the new node as mutable to signal to users of the new object
         # that it may change on subsequent loop iterations
         prev_node._mutable = True
         while True:
-            try:
-                prev_node._subsarray[-1] = prev_node.subscript_previous()
-                yield prev_node
-            except YDBNodeEnd:
+            sub_previous = _yottadb.subscript_previous(prev_node._name, prev_node._subsarray, None)
+            if sub_previous is None:
                 return
+            prev_node._set_leaf(sub_previous)
+            yield prev_node
 
     def __call__(self, *args) -> Node:
         """
@@ -979,16 +2356,22 @@ class Node:
         :param args: A list of bytes-like objects representing the YottaDB subscripts.
         :returns: None.
         """
-        return Node(self._name, self._subsarray + list(args))
+        node = self
+        for subscript in args:
+            node = node._child(subscript)
+        return node if node is not self else self.copy()
 
-    def get(self) -> Optional[bytes]:
+    def get(self, decode: str = None, errors: str = "strict") -> Optional[AnyStr]:
         """
         Retrieve the value of the local or global variable node represented by
         the current `Node` object.
 
-        :returns: If the specified node has a value, returns it as a bytes object. If not, returns None.
+        :param decode: The encoding with which to decode the value into a str object, e.g. "utf-8", or None for a bytes object.
+        :param errors: The error handler for decoding, e.g. "strict", "replace" or "surrogateescape".
+        :returns: If the specified node has a value, returns it as a bytes object, or a str object if `decode` is given.
+            If not, returns None.
         """
-        return get(self._name, self._subsarray)
+        return get(self._name, self._subsarray, decode, errors)
 
     def set(self, value: AnyStr = "") -> None:
         """
@@ -1007,12 +2390,14 @@ class Node:
         :param name: A bytes-like object representing the a YottaDB variable name or subscript.
         :returns: A new, mutable `Node` object.
         """
-        if len(self._subsarray) > 0:
+        if self._depth > 0:
             if self.mutable:
-                self._subsarray[-1] = name
+                self._set_leaf(name)
                 mutable = self
+            elif self._parent is not None:
+                mutable = self._parent._child(name)
             else:
-                mutable = Node(self._name, self._subsarray[:-1] + [name])
+                mutable = Node(self._name, self._path[:-1] + [name])
         else:
             if self.mutable:
                 self._name = name
@@ -1029,7 +2414,18 @@ class Node:
 
         :returns: A new, immutable `Node` object that duplicates the caller.
         """
-        return Node(self._name, self._subsarray)
+        if self._parent is None:
+            return Node(self._name, self._path)
+        # The parent of a linked Node is immutable, so the copy may share it
+        duplicate = Node.__new__(Node)
+        duplicate._name = self._name
+        duplicate._parent = self._parent
+        duplicate._leaf = self._leaf
+        duplicate._depth = self._depth
+        duplicate._path = None
+        duplicate._hash = None
+        duplicate._mutable = False
+        return duplicate
 
     @property
     def data(self) -> int:
@@ -1046,6 +2442,16 @@ class Node:
         """
         return data(self._name, self._subsarray)
 
+    def fetch(self) -> Tuple[int, Optional[bytes]]:
+        """
+        Get both the data status and the value of the local or global variable node represented by the current
+        `Node` object in a single call.
+
+        :returns: A tuple of the form `(data_status, value)`, where `data_status` is 0, 1, 10, or 11 as returned by `data`,
+            and `value` is the value of the node as a bytes object, or None if the node has no value.
+        """
+        return fetch(self._name, self._subsarray)
+
     @property
     def leaf(self) -> AnyStr:
         """
@@ -1054,8 +2460,8 @@ class Node:
 
         :returns: A bytes-like object representing the leaf node of the calling `Node` object.
         """
-        if len(self._subsarray) > 0:
-            return self._subsarray[-1]
+        if self._depth > 0:
+            return self._leaf
         else:
             return self._name
 
@@ -1066,7 +2472,9 @@ class Node:
 
         :returns: A `Node` object representing the parent node of the calling `Node` object.
         """
-        return Node(self._name, self._subsarray[:-1])
+        if self._parent is not None:
+            return self._parent
+        return Node(self._name, self._path[:-1])
 
     @property
     def name(self) -> AnyStr:
@@ -1096,6 +2504,38 @@ class Node:
         """
         delete_tree(self._name, self._subsarray)
 
+    def compare_and_set(self, expected: AnyStr, value: AnyStr) -> bool:
+        """
+        In a single transaction, sets the local or global variable node represented by the current `Node` object to
+        `value` if its value is `expected`. If `expected` is None, the node must have no value, and if `value` is None,
+        the node is deleted instead of set. See `compare_and_set()` for details.
+
+        :param expected: A bytes-like object representing the value the node must have, or None if it must have no value.
+        :param value: A bytes-like object representing the new value of the node, or None to delete it.
+        :returns: True if the value of the node was `expected`, or False otherwise.
+        """
+        return compare_and_set(self._name, self._subsarray, expected, value)
+
+    def set_if_absent(self, value: AnyStr = "") -> bool:
+        """
+        In a single transaction, sets the local or global variable node represented by the current `Node` object to
+        `value` if the node has no value.
+
+        :param value: A bytes-like object representing the new value of the node.
+        :returns: True if the node was set, or False if it already had a value.
+        """
+        return set_if_absent(self._name, self._subsarray, value)
+
+    def delete_if_equals(self, expected: AnyStr) -> bool:
+        """
+        In a single transaction, deletes the value at the local or global variable node represented by the current
+        `Node` object if it is `expected`.
+
+        :param expected: A bytes-like object representing the value the node must have.
+        :returns: True if the value was deleted, or False if the node had a different value or none.
+        """
+        return delete_if_equals(self._name, self._subsarray, expected)
+
     def incr(self, increment: Union[int, float, str, bytes] = "1") -> bytes:
         """
         Increments the value of the local or global variable node represented by the current `Node` object
@@ -1169,6 +2609,15 @@ class Node:
     def load_tree(self) -> dict:
         return load_tree(self, first_call=True)
 
+    def view(self) -> NodeView:
+        """
+        Create a dictionary-like view of the subtree under the local or global variable node represented by the current `Node`
+        object. Unlike `load_tree()`, the subtree is not read up front, but only as its nodes are accessed.
+
+        :returns: A `NodeView` object.
+        """
+        return NodeView(self)
+
     def save_tree(self, tree: dict, node: Node = None):
         """
         Stores data from a nested Python dictionary in YottaDB. The dictionary must have been previously created using the
@@ -1260,8 +2709,7 @@ class Node:
             return {}
         if node_status == 10:
             # The node has a subtree, which represents a JSON array or a JSON object.
-            for index, sub in enumerate(node.subscripts, start=1):
-                sub = sub.decode("utf-8")
+            for index, sub in enumerate(subscripts(node.name, list(node.subsarray) + [""], decode="utf-8"), start=1):
                 if str(index) == sub:
                     # The subtree represents a JSON array. This is so when the subscripts form a
                     # series of integers starting from 1, e.g. 1, 2, 3, etc. In that case, treat them
@@ -1282,7 +2730,7 @@ class Node:
             #
             # Note that `node_status` may be 11 in the case of a string literal, due to a "\s" node
             # stored by `Node.save_json()`. In that case, 11 is acceptable.
-            value = node.value.decode("utf-8")
+            value = get(node._name, node._subsarray, decode="utf-8")
             if node["\\s"].data == 1:
                 # A `"\s"` node accompanies the given value, signifying that the value is a string literal.
                 # In that case, no type conversion is necessary.
@@ -1333,6 +2781,29 @@ class Node:
         # Value must be str or bytes
         set(self._name, self._subsarray, value)
 
+    @property
+    def int_value(self) -> Optional[int]:
+        """
+        Retrieve the value of the local or global variable node represented by the current `Node` object as an int.
+
+        :returns: If the specified node has a value, returns it as an int. If not, returns None.
+        :raises ValueError: If the value of the node is not an integer.
+        """
+        return get_int(self._name, self._subsarray)
+
+    @int_value.setter
+    def int_value(self, value: int) -> None:
+        """
+        Set the value of the local or global variable node represented by the current `Node` object to an int.
+
+        :param value: An int representing the value of a YottaDB local or global variable node.
+        :returns: None.
+        """
+        # bool is a subclass of int, but True and False are not meant to be stored as 1 and 0
+        if not isinstance(value, int) or isinstance(value, bool):
+            raise TypeError("'value' must be an instance of int")
+        set(self._name, self._subsarray, str(value))
+
     @property
     def has_value(self):
         """
@@ -1341,10 +2812,8 @@ class Node:
 
         :returns: `True` if the node has a value, `False` otherwise.
         """
-        if self.data == YDB_DATA_VALUE_NODESC or self.data == YDB_DATA_VALUE_DESC:
-            return True
-        else:
-            return False
+        status = self.data
+        return YDB_DATA_VALUE_NODESC == status or YDB_DATA_VALUE_DESC == status
 
     @property
     def has_subtree(self):
@@ -1354,10 +2823,8 @@ class Node:
 
         :returns: `True` if the node has a subtree, `False` otherwise.
         """
-        if self.data == YDB_DATA_NOVALUE_DESC or self.data == YDB_DATA_VALUE_DESC:
-            return True
-        else:
-            return False
+        status = self.data
+        return YDB_DATA_NOVALUE_DESC == status or YDB_DATA_VALUE_DESC == status
 
     @property
     def has_both(self):
@@ -1367,10 +2834,7 @@ class Node:
 
         :returns: `True` if the node has both a value and a subtree, `False` otherwise.
         """
-        if self.data == YDB_DATA_VALUE_DESC:
-            return True
-        else:
-            return False
+        return YDB_DATA_VALUE_DESC == self.data
 
     @property
     def has_neither(self):
@@ -1380,10 +2844,7 @@ class Node:
 
         :returns: `True` if the node has neither a value nor a subtree, `False` otherwise.
         """
-        if self.data == YDB_DATA_UNDEF:
-            return True
-        else:
-            return False
+        return YDB_DATA_UNDEF == self.data
 
     @property
     def subscripts(self) -> Generator:
@@ -1400,12 +2861,38 @@ class Node:
             subscript_subsarray: List[AnyStr] = []
         subscript_subsarray.append("")
         while True:
-            try:
-                sub_next = subscript_next(self._name, subscript_subsarray)
-                subscript_subsarray[-1] = sub_next
-                yield sub_next
-            except YDBNodeEnd:
+            sub_next = _yottadb.subscript_next(self._name, subscript_subsarray, None)
+            if sub_next is None:
                 return
+            subscript_subsarray[-1] = sub_next
+            yield sub_next
+
+    def items(self, data: bool = False, decode: str = None, errors: str = "strict") -> Generator:
+        """
+        A Generator that yields a `(subscript, value)` tuple for each child subscript of the local or global variable node
+        represented by the calling `Node` object. See `items()` for details.
+
+        :param data: Whether to also yield the data status of each child, as returned by `data()`.
+        :param decode: The encoding with which to decode the subscripts and values into str objects, e.g. "utf-8", or None
+            for bytes objects.
+        :param errors: The error handler for decoding, e.g. "strict", "replace" or "surrogateescape".
+        :returns: A tuple of the form `(subscript, value)`, or `(subscript, value, data_status)` if `data` is set.
+        """
+        return items(self._name, self._subsarray, data, decode, errors)
+
+    def walk(self, max_depth: int = None, relative: bool = False, decode: str = None, errors: str = "strict") -> Generator:
+        """
+        A Generator that yields a `(subsarray, value)` tuple for each node with a value in the subtree of the local or
+        global variable node represented by the calling `Node` object. See `walk()` for details.
+
+        :param max_depth: The maximum number of levels below the node to traverse, or None for no limit.
+        :param relative: Whether to yield subscript arrays relative to the node rather than to the variable.
+        :param decode: The encoding with which to decode the subscripts and values into str objects, e.g. "utf-8", or None
+            for bytes objects.
+        :param errors: The error handler for decoding, e.g. "strict", "replace" or "surrogateescape".
+        :returns: A tuple of the form `(subsarray, value)`.
+        """
+        return walk(self._name, self._subsarray, max_depth, relative, decode, errors)
 
 
 class Key(Node):
@@ -1416,6 +2903,74 @@ class Key(Node):
     pass
 
 
+class Template:
+    """
+    A YottaDB local or global variable node of which some subscripts are placeholders, for repeated access to nodes of the
+    same shape, e.g. `^acct(?,"bal")`. The variable name and the constant subscripts are validated and converted once, when the
+    `Template` is created, and each access only fills in the placeholder subscripts.
+    """
+
+    __slots__ = ("_template",)
+
+    def __init__(self, name: AnyStr, subsarray: Tuple[Optional[AnyStr]] = ()) -> Template:
+        """
+        Creates a `Template` object from a local or global variable name and a subscript array.
+
+        :param name: A bytes-like object representing a YottaDB local or global variable name.
+        :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts, where each `PARAM`
+            is a placeholder subscript.
+        :returns: A `Template` object.
+        """
+        self._template = _yottadb.template(name, subsarray)
+
+    def get(self, *params: AnyStr) -> Optional[bytes]:
+        """
+        Retrieve the value of the node of the template with the placeholder subscripts given by `params`.
+
+        :param params: Bytes-like objects representing the placeholder subscripts, in order.
+        :returns: If the specified node has a value, returns it as a bytes object. If not, returns None.
+        """
+        return _yottadb.template_get(self._template, params)
+
+    def set(self, *params_and_value: AnyStr) -> None:
+        """
+        Set the node of the template with the placeholder subscripts given by all but the last argument, to the value
+        given by the last argument, e.g. `template.set("1234", "100")`.
+
+        :param params_and_value: Bytes-like objects representing the placeholder subscripts, in order, followed by the value.
+        :returns: None.
+        :raises TypeError: If no value is given.
+        """
+        if not params_and_value:
+            raise TypeError("Template.set() missing 1 required positional argument: 'value'")
+        _yottadb.template_set(self._template, params_and_value[:-1], params_and_value[-1])
+
+    def incr(self, *params: AnyStr, increment: Union[int, float, str, bytes] = "1") -> bytes:
+        """
+        Increment the value of the node of the template with the placeholder subscripts given by `params` by `increment`.
+
+        :param params: Bytes-like objects representing the placeholder subscripts, in order.
+        :param increment: A numeric value specifying the amount by which to increment the node.
+        :returns: The new value of the node as a bytes object.
+        """
+        if isinstance(increment, int) or isinstance(increment, float):
+            increment = str(increment)
+        return _yottadb.template_incr(self._template, params, increment)
+
+
+def template(name: AnyStr, subsarray: Tuple[Optional[AnyStr]] = ()) -> Template:
+    """
+    Create a `Template` for repeated access to the nodes of a local or global variable that differ only in the subscripts
+    given as `PARAM` in `subsarray`, e.g. `template("^acct", (PARAM, "bal")).get("1234")` retrieves `^acct("1234","bal")`.
+
+    :param name: A bytes-like object representing a YottaDB local or global variable name.
+    :param subsarray: A tuple of bytes-like objects representing an array of YottaDB subscripts, where each `PARAM`
+        is a placeholder subscript.
+    :returns: A `Template` object.
+    """
+    return Template(name, subsarray)
+
+
 # Defined after Node and Key classes to allow access to them
 def lock(nodes: Tuple[Node, Key, Tuple[AnyStr, Tuple[AnyStr]]] = None, timeout_nsec: int = 0) -> None:
     """
@@ -1447,17 +3002,9 @@ def transaction(function) -> Callable[..., object]:
     :returns: A Python function object that may calls `function` using `tp()`.
     """
 
+    # tp() treats a return value of None as YDB_OK and a YDBTPRestart exception as YDB_TP_RESTART, so `function` is passed
+    # to it directly rather than through another Python function called on each attempt of the transaction
     def wrapper(*args, **kwargs) -> int:
-        def wrapped_transaction(*args, **kwargs):
-            ret_val = YDB_OK
-            try:
-                ret_val = function(*args, **kwargs)
-                if ret_val is None:
-                    ret_val = YDB_OK
-            except YDBTPRestart:
-                ret_val = _yottadb.YDB_TP_RESTART
-            return ret_val
-
-        return _yottadb.tp(wrapped_transaction, args=args, kwargs=kwargs)
+        return _yottadb.tp(function, args=args, kwargs=kwargs)
 
     return wrapper